@@ -6,6 +6,7 @@
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <pthread.h>
 #include <sys/time.h>
 #include "include/lux_consensus.h"
 
@@ -39,6 +40,75 @@ static void generate_block_id(uint8_t* id) {
     }
 }
 
+// ============================================================================
+// HDR-style latency histogram: log-linear buckets (32 sub-buckets per
+// power of two), so relative error per bucket is bounded at ~3% across the
+// whole nanosecond-to-seconds range. Recording is one shift and an add —
+// cheap enough to keep inside the timed loop without distorting it.
+// ============================================================================
+
+#define HIST_SUB_BITS 5
+#define HIST_SUB (1u << HIST_SUB_BITS)
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS) * HIST_SUB)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t max_ns;
+} latency_hist_t;
+
+static void hist_record(latency_hist_t* h, uint64_t ns) {
+    size_t idx;
+    if (ns < HIST_SUB) {
+        idx = (size_t)ns;
+    } else {
+        int msb = 63 - __builtin_clzll(ns);
+        idx = (size_t)(msb - HIST_SUB_BITS + 1) * HIST_SUB +
+              ((ns >> (msb - HIST_SUB_BITS)) & (HIST_SUB - 1));
+    }
+    if (idx >= HIST_BUCKETS) {
+        idx = HIST_BUCKETS - 1;
+    }
+    h->counts[idx]++;
+    h->total++;
+    if (ns > h->max_ns) h->max_ns = ns;
+}
+
+static void hist_merge(latency_hist_t* into, const latency_hist_t* from) {
+    for (size_t i = 0; i < HIST_BUCKETS; i++) {
+        into->counts[i] += from->counts[i];
+    }
+    into->total += from->total;
+    if (from->max_ns > into->max_ns) into->max_ns = from->max_ns;
+}
+
+// Lower bound of a bucket; good enough for percentile reporting given the
+// 3% bucket width
+static uint64_t hist_bucket_value(size_t idx) {
+    size_t major = idx / HIST_SUB;
+    size_t minor = idx % HIST_SUB;
+    if (major == 0) {
+        return (uint64_t)minor;
+    }
+    return ((uint64_t)(HIST_SUB + minor)) << (major - 1);
+}
+
+static uint64_t hist_percentile(const latency_hist_t* h, double pct) {
+    if (h->total == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)((pct / 100.0) * (double)h->total);
+    if (target >= h->total) target = h->total - 1;
+    uint64_t cum = 0;
+    for (size_t i = 0; i < HIST_BUCKETS; i++) {
+        cum += h->counts[i];
+        if (cum > target) {
+            return hist_bucket_value(i);
+        }
+    }
+    return h->max_ns;
+}
+
 // Memory usage tracking
 typedef struct {
     size_t current_usage;
@@ -75,12 +145,12 @@ static void print_result(const benchmark_result_t* result) {
            result->name,
            result->avg_ns,
            result->ops_per_sec,
-           result->min_ns,
-           result->max_ns);
+           (unsigned long long)result->min_ns,
+           (unsigned long long)result->max_ns);
 }
 
 // Benchmark 1: Single block addition
-static benchmark_result_t benchmark_single_block_add(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_single_block_add(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Single Block Addition",
         .iterations = BENCHMARK_ITERATIONS,
@@ -106,7 +176,7 @@ static benchmark_result_t benchmark_single_block_add(lux_consensus_engine_t* eng
         block.data_size = BLOCK_DATA_SIZE;
 
         timer_start(&timer);
-        lux_consensus_add_block(engine, &block);
+        lux_chain_add_block(chain, &block);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -125,7 +195,7 @@ static benchmark_result_t benchmark_single_block_add(lux_consensus_engine_t* eng
 }
 
 // Benchmark 2: Batch block addition
-static benchmark_result_t benchmark_batch_block_add(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_batch_block_add(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Batch Block Addition (100 blocks)",
         .iterations = BENCHMARK_ITERATIONS / BATCH_SIZE,
@@ -154,7 +224,7 @@ static benchmark_result_t benchmark_batch_block_add(lux_consensus_engine_t* engi
 
         timer_start(&timer);
         for (int i = 0; i < BATCH_SIZE; i++) {
-            lux_consensus_add_block(engine, &blocks[i]);
+            lux_chain_add_block(chain, &blocks[i]);
         }
         timer_end(&timer);
 
@@ -171,7 +241,7 @@ static benchmark_result_t benchmark_batch_block_add(lux_consensus_engine_t* engi
 }
 
 // Benchmark 3: Single vote processing
-static benchmark_result_t benchmark_single_vote(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_single_vote(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Single Vote Processing",
         .iterations = BENCHMARK_ITERATIONS,
@@ -188,7 +258,7 @@ static benchmark_result_t benchmark_single_vote(lux_consensus_engine_t* engine)
     block.timestamp = time(NULL);
     block.data = NULL;
     block.data_size = 0;
-    lux_consensus_add_block(engine, &block);
+    lux_chain_add_block(chain, &block);
 
     lux_vote_t vote;
     memcpy(vote.block_id, block.id, 32);
@@ -201,7 +271,7 @@ static benchmark_result_t benchmark_single_vote(lux_consensus_engine_t* engine)
         generate_block_id(vote.voter_id);
 
         timer_start(&timer);
-        lux_consensus_process_vote(engine, &vote);
+        lux_consensus_process_vote(chain, &vote);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -220,7 +290,7 @@ static benchmark_result_t benchmark_single_vote(lux_consensus_engine_t* engine)
 }
 
 // Benchmark 4: Batch vote processing
-static benchmark_result_t benchmark_batch_vote(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_batch_vote(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Batch Vote Processing (100 votes)",
         .iterations = BENCHMARK_ITERATIONS / BATCH_SIZE,
@@ -237,7 +307,7 @@ static benchmark_result_t benchmark_batch_vote(lux_consensus_engine_t* engine) {
     block.timestamp = time(NULL);
     block.data = NULL;
     block.data_size = 0;
-    lux_consensus_add_block(engine, &block);
+    lux_chain_add_block(chain, &block);
 
     lux_vote_t votes[BATCH_SIZE];
     for (int i = 0; i < BATCH_SIZE; i++) {
@@ -254,9 +324,7 @@ static benchmark_result_t benchmark_batch_vote(lux_consensus_engine_t* engine) {
         }
 
         timer_start(&timer);
-        for (int i = 0; i < BATCH_SIZE; i++) {
-            lux_consensus_process_vote(engine, &votes[i]);
-        }
+        lux_consensus_process_votes(chain, votes, BATCH_SIZE, NULL);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -272,7 +340,7 @@ static benchmark_result_t benchmark_batch_vote(lux_consensus_engine_t* engine) {
 }
 
 // Benchmark 5: Finalization checking (is_accepted)
-static benchmark_result_t benchmark_finalization_check(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_finalization_check(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Finalization Check (is_accepted)",
         .iterations = BENCHMARK_ITERATIONS,
@@ -292,7 +360,7 @@ static benchmark_result_t benchmark_finalization_check(lux_consensus_engine_t* e
         block.timestamp = time(NULL);
         block.data = NULL;
         block.data_size = 0;
-        lux_consensus_add_block(engine, &block);
+        lux_chain_add_block(chain, &block);
     }
 
     benchmark_timer_t timer;
@@ -302,7 +370,7 @@ static benchmark_result_t benchmark_finalization_check(lux_consensus_engine_t* e
         uint8_t* block_id = block_ids[i % 10];
 
         timer_start(&timer);
-        lux_consensus_is_accepted(engine, block_id, &is_accepted);
+        lux_consensus_is_accepted(chain, block_id, &is_accepted);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -318,7 +386,7 @@ static benchmark_result_t benchmark_finalization_check(lux_consensus_engine_t* e
 }
 
 // Benchmark 6: Get preference
-static benchmark_result_t benchmark_get_preference(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_get_preference(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Get Preference",
         .iterations = BENCHMARK_ITERATIONS,
@@ -332,7 +400,7 @@ static benchmark_result_t benchmark_get_preference(lux_consensus_engine_t* engin
 
     for (uint32_t i = 0; i < result.iterations; i++) {
         timer_start(&timer);
-        lux_consensus_get_preference(engine, block_id);
+        lux_consensus_get_preference(chain, block_id);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -348,7 +416,7 @@ static benchmark_result_t benchmark_get_preference(lux_consensus_engine_t* engin
 }
 
 // Benchmark 7: Poll operation
-static benchmark_result_t benchmark_poll(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_poll(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Poll Operation (10 validators)",
         .iterations = BENCHMARK_ITERATIONS / 100, // Less iterations for polling
@@ -371,7 +439,7 @@ static benchmark_result_t benchmark_poll(lux_consensus_engine_t* engine) {
 
     for (uint32_t i = 0; i < result.iterations; i++) {
         timer_start(&timer);
-        lux_consensus_poll(engine, NUM_VALIDATORS, validator_ptrs);
+        lux_consensus_poll(chain, NUM_VALIDATORS, validator_ptrs);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -387,7 +455,7 @@ static benchmark_result_t benchmark_poll(lux_consensus_engine_t* engine) {
 }
 
 // Benchmark 8: Get statistics
-static benchmark_result_t benchmark_get_stats(lux_consensus_engine_t* engine) {
+static benchmark_result_t benchmark_get_stats(lux_chain_t* chain) {
     benchmark_result_t result = {
         .name = "Get Statistics",
         .iterations = BENCHMARK_ITERATIONS,
@@ -401,7 +469,7 @@ static benchmark_result_t benchmark_get_stats(lux_consensus_engine_t* engine) {
 
     for (uint32_t i = 0; i < result.iterations; i++) {
         timer_start(&timer);
-        lux_consensus_get_stats(engine, &stats);
+        lux_consensus_get_stats(chain, &stats);
         timer_end(&timer);
 
         uint64_t elapsed = timer_elapsed_ns(&timer);
@@ -450,7 +518,7 @@ static void benchmark_memory_usage(void) {
 }
 
 // Stress test: Maximum throughput
-static void benchmark_max_throughput(lux_consensus_engine_t* engine) {
+static void benchmark_max_throughput(lux_chain_t* chain) {
     printf("\n=== Maximum Throughput Test (1 second) ===\n");
 
     lux_block_t block;
@@ -476,7 +544,7 @@ static void benchmark_max_throughput(lux_consensus_engine_t* engine) {
         block.data = NULL;
         block.data_size = 0;
 
-        if (lux_consensus_add_block(engine, &block) == LUX_SUCCESS) {
+        if (lux_chain_add_block(chain, &block) == LUX_SUCCESS) {
             blocks_added++;
             memcpy(parent_id, block.id, 32);
 
@@ -486,7 +554,7 @@ static void benchmark_max_throughput(lux_consensus_engine_t* engine) {
                 memcpy(vote.block_id, block.id, 32);
                 vote.is_preference = (v % 2 == 0);
 
-                if (lux_consensus_process_vote(engine, &vote) == LUX_SUCCESS) {
+                if (lux_consensus_process_vote(chain, &vote) == LUX_SUCCESS) {
                     votes_processed++;
                 }
             }
@@ -498,7 +566,197 @@ static void benchmark_max_throughput(lux_consensus_engine_t* engine) {
     printf("Combined ops:     %8u ops/sec\n", blocks_added + votes_processed);
 }
 
-int main(void) {
+// ============================================================================
+// Multithreaded contention benchmarks: N producer threads hammer a shared
+// chain, each op is timed individually into a per-thread histogram (no
+// shared state inside the timed loop), then the histograms are merged for
+// the percentile report. Run with `./benchmark mt` / `make run-benchmark-mt`.
+// ============================================================================
+
+#define MT_VOTE_OPS_PER_THREAD  100000
+#define MT_ADD_OPS_PER_THREAD   20000
+#define MT_TARGET_BLOCKS        64
+#define MT_MAX_THREADS          16
+
+typedef struct {
+    lux_chain_t* chain;
+    int thread_idx;
+    uint32_t ops;
+    uint64_t seed;
+    // Vote workload: round-robin over the pre-added target blocks
+    const uint8_t (*target_ids)[32];
+    latency_hist_t hist;
+} mt_worker_t;
+
+// splitmix64: per-thread, no shared rand() state in the hot loop
+static inline uint64_t mt_next_rand(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void* mt_vote_worker(void* arg) {
+    mt_worker_t* w = (mt_worker_t*)arg;
+    lux_vote_t vote;
+    memset(&vote, 0, sizeof(vote));
+    benchmark_timer_t timer;
+
+    for (uint32_t i = 0; i < w->ops; i++) {
+        uint64_t r = mt_next_rand(&w->seed);
+        memcpy(vote.voter_id, &r, sizeof(r));
+        vote.voter_id[8] = (uint8_t)w->thread_idx;
+        memcpy(vote.block_id, w->target_ids[i % MT_TARGET_BLOCKS], 32);
+        vote.is_preference = (i & 1) == 0;
+
+        timer_start(&timer);
+        lux_consensus_process_vote(w->chain, &vote);
+        timer_end(&timer);
+        hist_record(&w->hist, timer_elapsed_ns(&timer));
+    }
+    return NULL;
+}
+
+static void* mt_add_worker(void* arg) {
+    mt_worker_t* w = (mt_worker_t*)arg;
+    lux_block_t block;
+    memset(&block, 0, sizeof(block));
+    uint8_t data[BLOCK_DATA_SIZE];
+    memset(data, 0xCC, sizeof(data));
+    block.data = data;
+    block.data_size = sizeof(data);
+    benchmark_timer_t timer;
+
+    for (uint32_t i = 0; i < w->ops; i++) {
+        uint64_t r = mt_next_rand(&w->seed);
+        memcpy(block.id, &r, sizeof(r));
+        memcpy(block.id + 8, &i, sizeof(i));
+        block.id[16] = (uint8_t)w->thread_idx;
+        block.height = i;
+        block.timestamp = 0;
+
+        timer_start(&timer);
+        lux_chain_add_block(w->chain, &block);
+        timer_end(&timer);
+        hist_record(&w->hist, timer_elapsed_ns(&timer));
+    }
+    return NULL;
+}
+
+static void mt_print_row(int threads, uint64_t wall_ns,
+                         const latency_hist_t* hist) {
+    double secs = (double)wall_ns / 1e9;
+    printf("%7d | %12.0f | %8llu | %8llu | %8llu | %8llu | %9llu\n",
+           threads,
+           (double)hist->total / secs,
+           (unsigned long long)hist_percentile(hist, 50.0),
+           (unsigned long long)hist_percentile(hist, 95.0),
+           (unsigned long long)hist_percentile(hist, 99.0),
+           (unsigned long long)hist_percentile(hist, 99.9),
+           (unsigned long long)hist->max_ns);
+}
+
+// One contention run: fresh shared chain, `threads` workers, merged report
+static void mt_run(const char* workload, int threads,
+                   void* (*worker_fn)(void*), uint32_t ops_per_thread) {
+    (void)workload;
+
+    lux_config_t config = {
+        .node_count = 21,
+        .k = 20,
+        .alpha = 14,
+        .beta = 20
+    };
+    lux_chain_t* chain = lux_chain_new(&config);
+    if (!chain) {
+        fprintf(stderr, "mt_run: failed to create chain\n");
+        return;
+    }
+
+    // Pre-add the vote targets so the vote workload never misses
+    uint8_t target_ids[MT_TARGET_BLOCKS][32];
+    lux_block_t block;
+    memset(&block, 0, sizeof(block));
+    for (int i = 0; i < MT_TARGET_BLOCKS; i++) {
+        memset(block.id, 0, 32);
+        block.id[0] = (uint8_t)i;
+        block.id[31] = 0xB1;
+        block.height = i + 1;
+        lux_chain_add_block(chain, &block);
+        memcpy(target_ids[i], block.id, 32);
+    }
+
+    mt_worker_t workers[MT_MAX_THREADS];
+    pthread_t tids[MT_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+
+    benchmark_timer_t wall;
+    timer_start(&wall);
+    for (int t = 0; t < threads; t++) {
+        workers[t].chain = chain;
+        workers[t].thread_idx = t;
+        workers[t].ops = ops_per_thread;
+        workers[t].seed = 0x5DEECE66DULL * (t + 1);
+        workers[t].target_ids = target_ids;
+        pthread_create(&tids[t], NULL, worker_fn, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    timer_end(&wall);
+
+    latency_hist_t merged;
+    memset(&merged, 0, sizeof(merged));
+    for (int t = 0; t < threads; t++) {
+        hist_merge(&merged, &workers[t].hist);
+    }
+    mt_print_row(threads, timer_elapsed_ns(&wall), &merged);
+
+    lux_chain_destroy(chain);
+}
+
+static void benchmark_multithreaded(void) {
+    static const int thread_counts[] = {1, 2, 4, 8};
+    const size_t num_counts = sizeof(thread_counts) / sizeof(thread_counts[0]);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("========================================\n");
+    printf("  Multithreaded Contention Benchmarks\n");
+    printf("========================================\n");
+    printf("Cores online: %ld\n", cores);
+    printf("Latencies in nanoseconds per op.\n");
+
+    printf("\n=== Vote Processing (shared chain, %d ops/thread) ===\n",
+           MT_VOTE_OPS_PER_THREAD);
+    printf("threads |      ops/sec |      p50 |      p95 |      p99 |     p999 |       max\n");
+    printf("--------|--------------|----------|----------|----------|----------|----------\n");
+    for (size_t i = 0; i < num_counts; i++) {
+        mt_run("votes", thread_counts[i], mt_vote_worker,
+               MT_VOTE_OPS_PER_THREAD);
+    }
+
+    printf("\n=== Block Addition (shared chain, %d ops/thread) ===\n",
+           MT_ADD_OPS_PER_THREAD);
+    printf("threads |      ops/sec |      p50 |      p95 |      p99 |     p999 |       max\n");
+    printf("--------|--------------|----------|----------|----------|----------|----------\n");
+    for (size_t i = 0; i < num_counts; i++) {
+        mt_run("adds", thread_counts[i], mt_add_worker,
+               MT_ADD_OPS_PER_THREAD);
+    }
+}
+
+int main(int argc, char** argv) {
+    // `benchmark mt` runs only the multithreaded contention suite
+    if (argc > 1 && strcmp(argv[1], "mt") == 0) {
+        if (lux_consensus_init() != LUX_SUCCESS) {
+            fprintf(stderr, "Failed to initialize consensus library\n");
+            return 1;
+        }
+        benchmark_multithreaded();
+        lux_consensus_cleanup();
+        return 0;
+    }
+
     printf("========================================\n");
     printf("    Lux Consensus C Library Benchmarks\n");
     printf("========================================\n\n");
@@ -512,30 +770,25 @@ int main(void) {
         return 1;
     }
 
-    // Create consensus engine with default config
-    lux_consensus_config_t config = {
+    // Create a chain with a realistic validator-set config
+    lux_config_t config = {
+        .node_count = 21,
         .k = 20,
-        .alpha_preference = 14,
-        .alpha_confidence = 14,
-        .beta = 20,
-        .concurrent_polls = 10,
-        .optimal_processing = 50,
-        .max_outstanding_items = 1024,
-        .max_item_processing_time_ns = 1000000000, // 1 second
-        .engine_type = LUX_ENGINE_CHAIN
+        .alpha = 14,
+        .beta = 20
     };
 
-    lux_consensus_engine_t* engine = NULL;
-    if (lux_consensus_engine_create(&engine, &config) != LUX_SUCCESS) {
-        fprintf(stderr, "Failed to create consensus engine\n");
+    lux_chain_t* chain = lux_chain_new(&config);
+    if (!chain) {
+        fprintf(stderr, "Failed to create chain\n");
         lux_consensus_cleanup();
         return 1;
     }
 
     printf("Configuration:\n");
-    printf("  Engine Type: %s\n", lux_engine_type_string(config.engine_type));
-    printf("  k=%u, α_pref=%u, α_conf=%u, β=%u\n",
-           config.k, config.alpha_preference, config.alpha_confidence, config.beta);
+    printf("  Engine Type: %s\n", lux_engine_type_string(LUX_ENGINE_CHAIN));
+    printf("  nodes=%u, k=%u, α=%u, β=%u\n",
+           config.node_count, config.k, config.alpha, config.beta);
     printf("  Iterations: %d\n", BENCHMARK_ITERATIONS);
     printf("  Batch Size: %d\n\n", BATCH_SIZE);
 
@@ -543,14 +796,14 @@ int main(void) {
 
     // Run benchmarks
     benchmark_result_t results[] = {
-        benchmark_single_block_add(engine),
-        benchmark_batch_block_add(engine),
-        benchmark_single_vote(engine),
-        benchmark_batch_vote(engine),
-        benchmark_finalization_check(engine),
-        benchmark_get_preference(engine),
-        benchmark_poll(engine),
-        benchmark_get_stats(engine)
+        benchmark_single_block_add(chain),
+        benchmark_batch_block_add(chain),
+        benchmark_single_vote(chain),
+        benchmark_batch_vote(chain),
+        benchmark_finalization_check(chain),
+        benchmark_get_preference(chain),
+        benchmark_poll(chain),
+        benchmark_get_stats(chain)
     };
 
     // Print results
@@ -560,23 +813,23 @@ int main(void) {
 
     // Get final statistics
     lux_consensus_stats_t stats;
-    lux_consensus_get_stats(engine, &stats);
+    lux_consensus_get_stats(chain, &stats);
 
     printf("\n=== Final Statistics ===\n");
-    printf("Blocks Accepted:  %llu\n", stats.blocks_accepted);
-    printf("Blocks Rejected:  %llu\n", stats.blocks_rejected);
-    printf("Votes Processed:  %llu\n", stats.votes_processed);
-    printf("Polls Completed:  %llu\n", stats.polls_completed);
+    printf("Blocks Accepted:  %llu\n", (unsigned long long)stats.blocks_accepted);
+    printf("Blocks Rejected:  %llu\n", (unsigned long long)stats.blocks_rejected);
+    printf("Votes Processed:  %llu\n", (unsigned long long)stats.votes_processed);
+    printf("Polls Completed:  %llu\n", (unsigned long long)stats.polls_completed);
     printf("Avg Decision Time: %.2f ms\n", stats.average_decision_time_ms);
 
     // Memory usage benchmark
     benchmark_memory_usage();
 
     // Maximum throughput test
-    benchmark_max_throughput(engine);
+    benchmark_max_throughput(chain);
 
     // Cleanup
-    lux_consensus_engine_destroy(engine);
+    lux_chain_destroy(chain);
     lux_consensus_cleanup();
 
     printf("\n========================================\n");
@@ -584,4 +837,4 @@ int main(void) {
     printf("========================================\n");
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,93 @@
+// cpp_wrapper.cpp — proof that the official C++ interface (lux_consensus.hpp)
+// drives the engine end to end: a movable lux::Chain owns the handle, batch
+// votes go through the templated span-style API straight into the C batch
+// call, and the decision lambda is stored inline in the Chain (no heap).
+//
+// Build & run:  make test-cpp-wrapper   (from pkg/c/)
+//
+// Expected tail:  "C++ RAII wrapper reached consensus finality"
+
+#include <cstdio>
+#include <vector>
+
+#include "lux_consensus.hpp"
+
+int main() {
+    std::printf("== C++ RAII wrapper over libluxconsensus ==\n");
+
+    if (lux_consensus_init() != LUX_SUCCESS) {
+        std::printf("init failed\n");
+        return 1;
+    }
+
+    lux::Config cfg{};
+    cfg.node_count = 5;
+    cfg.k = 3;
+    cfg.alpha = 3;
+    cfg.beta = 4;
+
+    lux::Chain chain(cfg);
+    if (!chain || chain.start() != LUX_SUCCESS) {
+        std::printf("chain start failed\n");
+        return 1;
+    }
+
+    // Decision lambda with a small capture: stored inline in the Chain
+    int decisions_seen = 0;
+    chain.on_decision([&decisions_seen](lux::BlockId id) {
+        ++decisions_seen;
+        std::printf("decision callback: block finalized (id[0]=0x%02X)\n",
+                    id.bytes[0]);
+    });
+
+    // Moving the Chain must keep the registered lambda working
+    lux::Chain moved = std::move(chain);
+
+    lux::Block blk{};
+    for (int i = 0; i < 32; ++i) {
+        blk.id[i] = static_cast<uint8_t>(0xC0 + i);
+    }
+    blk.height = 1;
+    blk.timestamp = 1700000000;
+    if (moved.add_block(blk) != LUX_SUCCESS) {
+        std::printf("add_block failed\n");
+        return 1;
+    }
+
+    // Batch votes through the templated range API (forwards to the C batch
+    // entry point; the vector is the only allocation here)
+    std::vector<lux::Vote> votes(8);
+    for (std::size_t i = 0; i < votes.size(); ++i) {
+        std::memcpy(votes[i].block_id, blk.id, 32);
+        votes[i].voter_id[0] = static_cast<uint8_t>(i + 1);
+        votes[i].is_preference = (i % 2 == 0);
+    }
+    std::vector<lux_error_t> results(votes.size());
+    if (moved.process_votes(votes, results.data()) != LUX_SUCCESS) {
+        std::printf("process_votes failed\n");
+        return 1;
+    }
+
+    const lux::BlockId id = lux::BlockId::copy_from(blk.id);
+    if (!moved.is_accepted(id)) {
+        std::printf("block not accepted\n");
+        return 1;
+    }
+    if (decisions_seen == 0) {
+        std::printf("decision callback never fired\n");
+        return 1;
+    }
+
+    const lux::Stats stats = moved.stats();
+    std::printf("accepted=%llu votes=%llu decisions_seen=%d\n",
+                static_cast<unsigned long long>(stats.blocks_accepted),
+                static_cast<unsigned long long>(stats.votes_processed),
+                decisions_seen);
+
+    moved.stop();
+    moved.reset();
+    lux_consensus_cleanup();
+
+    std::printf("== C++ RAII wrapper reached consensus finality ==\n");
+    return 0;
+}
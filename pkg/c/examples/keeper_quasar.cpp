@@ -179,7 +179,18 @@ int main()
         {Op::ERASE,  "/clickhouse/tables/events/replicas/r2", ""},
     };
 
+    // Pipelined submission: every log entry goes in flight immediately, each
+    // block's parent_id chained to the previous entry, and the engine's
+    // ordered decision delivery guarantees commit fires parent-before-child
+    // exactly once. No stop-and-wait per entry, no driver-side fallback —
+    // throughput is depth-of-pipeline per finality round instead of 1.
+    std::vector<std::vector<uint8_t>> payloads;   // keep blocks' data alive
+    std::vector<std::array<uint8_t, 32>> ids;
+    payloads.reserve(script.size());
+    ids.reserve(script.size());
+
     uint64_t height = 0;
+    uint8_t prev_id[32] = {0};
     for (const auto & op : script) {
         ++height;
 
@@ -187,14 +198,14 @@ int main()
         // Distinct, deterministic block id per log entry.
         for (int i = 0; i < 32; ++i)
             blk.id[i] = static_cast<uint8_t>((height * 7u + i) & 0xff);
-        std::memset(blk.parent_id, 0, 32);
+        std::memcpy(blk.parent_id, prev_id, 32); // chain to the previous entry
         blk.height = height;
         blk.timestamp = 1700000000ull + height;
 
         // The op rides consensus as the log entry payload.
-        std::vector<uint8_t> payload = encode(op);
-        blk.data = payload.data();
-        blk.data_size = payload.size();
+        payloads.push_back(encode(op));
+        blk.data = payloads.back().data();
+        blk.data_size = payloads.back().size();
 
         auto k = key_of(blk.id);
         driver.pending[k] = op;       // preprocess: hold the request
@@ -205,30 +216,34 @@ int main()
                         static_cast<unsigned long long>(height));
             return 1;
         }
+        std::memcpy(prev_id, blk.id, 32);
+        ids.push_back(k);
+    }
 
-        // Drive confidence votes until this entry finalizes (commit fires via callback).
-        bool accepted = false;
-        for (uint32_t v = 0; v < cfg.beta && !accepted; ++v) {
+    // Drive confidence votes for every in-flight entry concurrently — one
+    // batch covers the whole pipeline depth.
+    std::vector<lux_vote_t> votes;
+    for (uint32_t v = 0; v < cfg.beta; ++v) {
+        for (const auto & id : ids) {
             lux_vote_t vote{};
-            std::memcpy(vote.block_id, blk.id, 32);
+            std::memcpy(vote.block_id, id.data(), 32);
             for (int i = 0; i < 32; ++i)
                 vote.voter_id[i] = static_cast<uint8_t>(v + 1);
             vote.is_preference = false;
-            lux_consensus_process_vote(chain, &vote);
-            lux_consensus_is_accepted(chain, blk.id, &accepted);
+            votes.push_back(vote);
         }
+    }
+    lux_consensus_process_votes(chain, votes.data(), votes.size(), nullptr);
+
+    for (std::size_t e = 0; e < script.size(); ++e) {
+        bool accepted = false;
+        lux_consensus_is_accepted(chain, ids[e].data(), &accepted);
         if (!accepted) {
-            std::printf("entry %llu did not finalize\n",
-                        static_cast<unsigned long long>(height));
+            std::printf("entry %zu did not finalize\n", e + 1);
             return 2;
         }
-        // Belt and suspenders: if the engine did not invoke the callback, the
-        // pending op is still here — apply it so commit is exactly-once either way.
-        if (driver.pending.count(k))
-            on_decision(blk.id, &driver);
-
-        std::printf("  log[%llu] committed: %s %s\n",
-                    static_cast<unsigned long long>(height),
+        const Op & op = script[e];
+        std::printf("  log[%zu] committed: %s %s\n", e + 1,
                     op.kind == Op::CREATE ? "CREATE" : op.kind == Op::SET ? "SET" : "ERASE",
                     op.key.c_str());
     }
@@ -25,6 +25,7 @@ typedef enum {
     LUX_ERROR_INVALID_STATE = -3,
     LUX_ERROR_CONSENSUS_FAILED = -4,
     LUX_ERROR_NOT_IMPLEMENTED = -5,
+    LUX_ERROR_QUEUE_FULL = -6,
 } lux_error_t;
 
 // Consensus engine types
@@ -36,6 +37,7 @@ typedef enum {
 
 // Forward declarations
 typedef struct lux_chain lux_chain_t;
+typedef struct lux_engine_group lux_engine_group_t;
 typedef struct lux_config lux_config_t;
 typedef struct lux_vote lux_vote_t;
 typedef struct lux_block lux_block_t;
@@ -46,6 +48,17 @@ struct lux_config {
     uint32_t k;                      // Sample size (optional, 0 for default)
     uint32_t alpha;                  // Quorum size (optional, 0 for default)
     uint32_t beta;                   // Decision threshold (optional, 0 for default)
+    uint32_t vote_cache_capacity;    // Vote analytics ring size (optional, 0 for default)
+
+    // Capacity hints (optional, 0 to start cold and grow on demand).
+    // When set, lux_chain_new presizes the block table, preallocates the
+    // node slab, and reserves the vote-analytics ring up front, so the
+    // vote path makes no allocator calls and the block path makes none
+    // until the hints are exceeded. expected_children_per_block sizes a
+    // parent's first children array, avoiding realloc-under-mutex for
+    // parents with known fan-out.
+    uint32_t expected_blocks;
+    uint32_t expected_children_per_block;
 };
 
 // Block structure
@@ -65,11 +78,25 @@ struct lux_vote {
     bool is_preference;    // Is this a preference vote?
 };
 
+// Visitor for lux_chain_iterate_accepted. Return false to stop early.
+// The lux_block_t view (including its data pointer) is valid for the
+// duration of the call only.
+typedef bool (*lux_callback_block_visit)(const lux_block_t* block, void* user_data);
+
 // Callback function types
 typedef void (*lux_callback_decision)(const uint8_t* block_id, void* user_data);
+// Block admission check. Invoked outside all engine locks, possibly from
+// several adder threads at once, so an expensive verification (signature
+// checks over block->data) never serializes the engine — the callback must
+// be thread-safe. Returning false rejects the block before it enters the
+// block table.
 typedef bool (*lux_callback_verify)(const lux_block_t* block, void* user_data);
 typedef void (*lux_callback_notify)(const char* event, void* user_data);
 
+// Release callback for zero-copy block payloads: invoked exactly once when
+// the engine is done with a buffer handed over via lux_chain_add_block_owned.
+typedef void (*lux_callback_release)(void* data, size_t data_size, void* user_data);
+
 // Core API functions
 
 // Initialize the consensus library
@@ -84,9 +111,83 @@ lux_chain_t* lux_chain_new_default(void);
 // Create a new chain with custom config
 lux_chain_t* lux_chain_new(const lux_config_t* config);
 
+// Create a chain backed by a memory-mapped append-only block log at path.
+// Accepted blocks are appended as checksummed records; if the file already
+// exists its contents are replayed (one sequential scan of the mapping)
+// before this returns, so the chain resumes where the previous process
+// stopped. A torn tail from a crash mid-append is detected and clipped.
+// Pass NULL config for defaults. Returns NULL if the file cannot be opened
+// or is not a valid block log.
+lux_chain_t* lux_chain_open(const char* path, const lux_config_t* config);
+
+// Attach a write-ahead vote journal at path. Applied votes are appended as
+// fixed-size checksummed records through a double-buffered writer with group
+// commit — one fdatasync per processed batch, not per vote — so a restarted
+// node recovers accumulated preference/confidence counts for undecided
+// blocks instead of re-gathering rounds from the network. If the file
+// already holds records they are replayed through the batch-vote path before
+// this returns; attach after the blocks themselves are resident (e.g. after
+// lux_chain_open replay), since votes for unknown blocks are skipped. Once
+// every journaled vote references a decided block the file is truncated
+// automatically. *replayed (optional) receives the number of records
+// replayed. Returns LUX_ERROR_INVALID_STATE if a journal is already
+// attached or the file is not a valid journal.
+lux_error_t lux_consensus_attach_vote_journal(
+    lux_chain_t* engine,
+    const char* path,
+    size_t* replayed
+);
+
+// Prune decided history below the finalized frontier: evicts hash-table
+// entries, block nodes, children arrays, and payloads for every decided
+// block whose height is under below_height and whose children are all
+// decided, so surviving blocks keep the parents they still need. The
+// current preference and genesis always survive. *bytes_reclaimed
+// (optional) receives the bytes returned to the allocator (node structs are
+// recycled through the slab freelist and counted). Combined with
+// lux_chain_open, old state lives on disk and RAM holds the active tail.
+lux_error_t lux_chain_prune(
+    lux_chain_t* chain,
+    uint64_t below_height,
+    size_t* bytes_reclaimed
+);
+
 // Destroy a chain
 void lux_chain_destroy(lux_chain_t* chain);
 
+// Shared worker pool for processes running many chains (one coordination
+// log per replicated table). Chains registered with a group have their
+// async vote queues drained by the group's workers instead of a dedicated
+// per-chain thread: idle chains cost zero threads, hot chains are picked
+// up by whichever worker reaches them first, and rotating scan offsets
+// spread the load. num_workers 0 picks a default from the core count.
+lux_engine_group_t* lux_engine_group_new(uint32_t num_workers);
+
+// Register a chain with the group. The chain's submit queue is initialized
+// and lux_consensus_submit_vote starts accepting immediately; the group
+// replaces the per-chain worker, and lux_chain_start on a registered chain
+// fails with LUX_ERROR_INVALID_STATE (the queue is strictly
+// single-consumer). Registration is a single slot claim, cheap enough to
+// do per-table at runtime. Fails with LUX_ERROR_INVALID_STATE when the
+// group is full, the chain is already registered with a group, or the
+// chain already runs its own pipeline thread.
+lux_error_t lux_engine_group_add(
+    lux_engine_group_t* group,
+    lux_chain_t* chain
+);
+
+// Deregister a chain: removes it from the workers' scan, waits for any
+// in-progress batch on it to finish, and drains whatever is still queued,
+// so no accepted vote is lost. Must be called before destroying the chain.
+lux_error_t lux_engine_group_remove(
+    lux_engine_group_t* group,
+    lux_chain_t* chain
+);
+
+// Stop the workers and drain every still-registered chain, then free the
+// group. Registered chains themselves are not destroyed.
+void lux_engine_group_destroy(lux_engine_group_t* group);
+
 // Start the chain
 lux_error_t lux_chain_start(lux_chain_t* chain);
 
@@ -99,12 +200,81 @@ lux_error_t lux_chain_add_block(
     const lux_block_t* block
 );
 
+// Zero-copy variant: ownership of block->data transfers to the engine, which
+// stores the pointer instead of copying the payload and calls `release` (if
+// non-NULL) once the block is torn down. The caller must keep the buffer
+// stable and must not free it; `free(3)` works directly as the release
+// callback for malloc'd buffers (user_data is then ignored by it).
+lux_error_t lux_chain_add_block_owned(
+    lux_chain_t* chain,
+    const lux_block_t* block,
+    lux_callback_release release,
+    void* release_user_data
+);
+
 // Process a vote
 lux_error_t lux_consensus_process_vote(
     lux_chain_t* engine,
     const lux_vote_t* vote
 );
 
+// Submit a vote to the chain's asynchronous ingest pipeline. Non-blocking:
+// the vote is pushed onto a lock-free multi-producer queue and applied by the
+// engine-owned consensus thread, so network threads never contend on engine
+// locks. The pipeline runs between lux_chain_start and lux_chain_stop;
+// submitting to a stopped chain returns LUX_ERROR_INVALID_STATE, and
+// LUX_ERROR_QUEUE_FULL signals backpressure (retry or fall back to
+// lux_consensus_process_vote). Decisions surface through the registered
+// decision callback as usual.
+lux_error_t lux_consensus_submit_vote(
+    lux_chain_t* engine,
+    const lux_vote_t* vote
+);
+
+// Process a batch of votes under a single lock acquisition.
+// Votes for the same block are grouped so each block node is touched once,
+// and the decision check runs once per affected node instead of once per
+// vote. `results` is optional: when non-NULL it must have room for
+// `num_votes` entries and receives the per-vote status (e.g.
+// LUX_ERROR_INVALID_STATE for votes on unknown blocks). The call itself
+// returns LUX_SUCCESS as long as the parameters are valid.
+lux_error_t lux_consensus_process_votes(
+    lux_chain_t* engine,
+    const lux_vote_t* votes,
+    size_t num_votes,
+    lux_error_t* results
+);
+
+// Compact binary wire format for vote batches ("LVF1"). All integers are
+// little-endian and the layout is packed (no padding):
+//
+//   u32  magic        LUX_VOTE_FRAME_MAGIC
+//   u16  num_voters   size of the voter table (1..32768)
+//   u16  num_groups   number of block groups
+//   voter table       num_voters * 32-byte voter IDs, each listed once
+//   groups            num_groups entries, sorted ascending by block_id:
+//     32-byte block_id
+//     u16  num_votes
+//     u16  entries[num_votes]  bits 0-14: index into the voter table,
+//                              bit 15 set: preference vote (else confidence)
+//
+// Repeated voters cost 2 bytes per vote instead of 32, and grouping by
+// block means one table probe per block rather than per vote.
+#define LUX_VOTE_FRAME_MAGIC 0x3146564Cu
+
+// Validate and apply a vote frame straight from the network buffer: no
+// intermediate lux_vote_t array, one hash probe and one decision check per
+// block group, all votes applied under a single lock acquisition. The
+// frame is fully validated (lengths, magic, sort order, voter indices)
+// before any vote is applied; a malformed frame returns
+// LUX_ERROR_INVALID_PARAMS and changes nothing. Votes for unknown blocks
+// are skipped, matching lux_consensus_process_votes.
+lux_error_t lux_consensus_ingest_vote_frame(
+    lux_chain_t* engine,
+    const uint8_t* frame,
+    size_t len
+);
+
 // Check if a block is accepted
 lux_error_t lux_consensus_is_accepted(
     lux_chain_t* engine,
@@ -112,19 +282,128 @@ lux_error_t lux_consensus_is_accepted(
     bool* is_accepted
 );
 
+// Bulk acceptance check for catch-up: out_flags[i] is 1 if ids[i] (32
+// bytes each, packed) is an accepted block, 0 if it is unknown, pending,
+// or rejected. Probes are grouped by table shard so each shard lock is
+// taken once per call and its entries stay hot in cache while every ID
+// routed to it is answered.
+lux_error_t lux_consensus_is_accepted_batch(
+    lux_chain_t* engine,
+    const uint8_t* ids,
+    size_t num_ids,
+    uint8_t* out_flags
+);
+
+// Highest height at which a block has been accepted (0 when nothing
+// beyond genesis is final). Maintained incrementally at decision time, so
+// this is a single atomic load.
+lux_error_t lux_consensus_get_finalized_height(
+    lux_chain_t* engine,
+    uint64_t* height
+);
+
 // Get preference
 lux_error_t lux_consensus_get_preference(
     lux_chain_t* engine,
     uint8_t* block_id
 );
 
-// Poll for consensus
+// Poll for consensus: runs one Snow sampling round (k validators drawn
+// without replacement) over the provided validator set
 lux_error_t lux_consensus_poll(
     lux_chain_t* engine,
     uint32_t num_validators,
     const uint8_t** validator_ids
 );
 
+// Sampling round with the query batch exposed so the network layer can fan
+// out. sampled_indices (room for min(k, num_validators) entries) receives
+// indices into validator_ids; *num_sampled the count; block_id_out (32
+// bytes, optional) the chain's current preference to query for. Sampling is
+// allocation-free per poll: the index pool and PRNG live in the chain.
+lux_error_t lux_consensus_poll_ex(
+    lux_chain_t* engine,
+    uint32_t num_validators,
+    const uint8_t** validator_ids,
+    uint32_t* sampled_indices,
+    uint32_t* num_sampled,
+    uint8_t* block_id_out
+);
+
+// Copy the accepted block at the given height into *out. The secondary
+// height index is a dense array maintained at acceptance time, so this is
+// one bounds check and one copy — no hash probe. Returns
+// LUX_ERROR_INVALID_STATE when no accepted block exists at that height
+// (never accepted, or pruned). out->data points at the engine-owned
+// payload and stays valid until the block is pruned or the chain
+// destroyed.
+lux_error_t lux_chain_get_block_by_height(
+    lux_chain_t* chain,
+    uint64_t height,
+    lux_block_t* out
+);
+
+// Visit every accepted block with from_height <= height <= to_height in
+// ascending height order: a linear scan over the dense height index, not
+// N hash probes, so sequential replay runs at prefetch speed. Blocks are
+// copied out in chunks and the callback runs outside all engine locks, so
+// it may call back into the API. Heights with no resident accepted block
+// (pruned, or never decided) are skipped. Returns the number of blocks
+// visited via *num_visited (optional).
+lux_error_t lux_chain_iterate_accepted(
+    lux_chain_t* chain,
+    uint64_t from_height,
+    uint64_t to_height,
+    lux_callback_block_visit visit,
+    void* user_data,
+    uint64_t* num_visited
+);
+
+// Drain up to max_decisions finalized block IDs from the internal ready
+// queue into block_ids_out (32 bytes per entry); *num_out receives the
+// count. Decisions are queued by the engine under its locks but delivered
+// only through this call or the registered decision callback, so user code
+// never runs inside the engine — a callback that re-enters the API can no
+// longer deadlock. When a decision callback is registered the engine pumps
+// the queue itself after each mutating call and this drain typically
+// returns 0.
+lux_error_t lux_consensus_drain_decisions(
+    lux_chain_t* engine,
+    size_t max_decisions,
+    uint8_t* block_ids_out,
+    size_t* num_out
+);
+
+// Binary engine events: fixed-size records written into a lock-free ring
+// per chain, cheap enough (a cell claim plus a few stores — no malloc, no
+// formatting) to stay enabled in production. This is the structured
+// replacement for the stringly-typed notify callback, which was never
+// fired. When the consumer falls behind, new events are dropped rather
+// than blocking the producer; the loss is counted and reported in the
+// `dropped` field of the next record that fits.
+typedef enum {
+    LUX_EVENT_BLOCK_ACCEPTED = 1,   // payload: block height
+    LUX_EVENT_BLOCK_REJECTED = 2,   // payload: block height
+    LUX_EVENT_VOTE_CACHE_EVICTED = 3, // payload: total evictions so far
+    LUX_EVENT_BLOCK_PRUNED = 4,     // payload: block height
+} lux_event_type_t;
+
+typedef struct {
+    uint32_t type;        // lux_event_type_t
+    uint32_t dropped;     // events lost to ring overflow since the last record
+    uint8_t block_id[32]; // subject block (zero for non-block events)
+    uint64_t payload;     // type-specific, see lux_event_type_t
+} lux_event_t;
+
+// Drain up to max_events records into events_out; *num_out receives the
+// count. Single consumer: poll from one thread (or serialize externally).
+lux_error_t lux_consensus_poll_events(
+    lux_chain_t* engine,
+    lux_event_t* events_out,
+    size_t max_events,
+    size_t* num_out
+);
+
 // Register callbacks
 lux_error_t lux_consensus_register_decision_callback(
     lux_chain_t* engine,
@@ -158,6 +437,99 @@ lux_error_t lux_consensus_get_stats(
     lux_consensus_stats_t* stats
 );
 
+// Extended hot-path instrumentation, populated from cheap per-chain
+// counters (relaxed atomics, no locks taken to read them). Versioned so
+// fields can be appended without breaking older callers: set `version` to
+// LUX_STATS_EX_VERSION before calling lux_consensus_get_stats_ex; a
+// mismatch returns LUX_ERROR_INVALID_PARAMS.
+#define LUX_STATS_EX_VERSION 1
+
+// Probe-length histogram buckets: 0..6 probes, last bucket is 7 or more
+#define LUX_PROBE_HIST_BUCKETS 8
+
+typedef struct {
+    uint32_t version;                 // in: LUX_STATS_EX_VERSION
+    lux_consensus_stats_t base;
+
+    // Hash-table lookups (find_block) and probe-length distribution
+    uint64_t table_lookups;
+    uint64_t probe_histogram[LUX_PROBE_HIST_BUCKETS];
+
+    // Time spent blocked acquiring engine locks on the vote path. Wait time
+    // is only measured when the lock was actually contended, so uncontended
+    // operation costs two extra instructions, not two clock reads.
+    uint64_t tree_lock_wait_ns;
+    uint64_t tree_lock_acquisitions;
+    uint64_t cache_lock_wait_ns;
+    uint64_t cache_lock_acquisitions;
+
+    // Vote analytics ring overwrites (ring was full, oldest record dropped)
+    uint64_t vote_cache_evictions;
+
+    // Children-array growth on block insertion
+    uint64_t children_reallocs;
+
+    // True decision latency: CLOCK_MONOTONIC nanoseconds from the block's
+    // add call to its acceptance in process_decision
+    uint64_t decisions_measured;
+    uint64_t decision_latency_total_ns;
+    uint64_t decision_latency_max_ns;
+} lux_consensus_stats_ex_t;
+
+// Decision-latency distribution: CLOCK_MONOTONIC nanoseconds from block
+// admission to acceptance, accumulated in a log-linear histogram inside
+// the chain (32 sub-buckets per power of two, ~3% value resolution).
+// Percentiles are reconstructed from the buckets on read, so recording a
+// sample is two relaxed atomic increments on the hot path. This is the
+// signal for latency SLOs ("entry final in < 5ms p99"), unlike the
+// wall-clock average_decision_time_ms in the base stats.
+typedef struct {
+    uint64_t count;    // decisions measured
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+} lux_latency_stats_t;
+
+lux_error_t lux_consensus_get_decision_latency(
+    lux_chain_t* engine,
+    lux_latency_stats_t* stats
+);
+
+lux_error_t lux_consensus_get_stats_ex(
+    lux_chain_t* engine,
+    lux_consensus_stats_ex_t* stats
+);
+
+// Per-structure memory accounting, maintained at the engine's allocation
+// sites: slab chunks, payloads, hash-table arrays, children arrays, the
+// vote cache, voter-dedup state (registry plus per-block bitmaps), and the
+// conflict-set/height-index structures. `current` is bytes held now; `peak`
+// is the high-water mark since chain creation. Block-node bytes come from
+// the slab pool, which only grows, so its current and peak coincide.
+// Together with lux_chain_prune this lets a multi-chain deployment set and
+// enforce per-chain memory budgets.
+typedef struct {
+    uint64_t current;
+    uint64_t peak;
+} lux_memory_category_t;
+
+typedef struct {
+    lux_memory_category_t block_nodes;     // slab chunks backing block nodes
+    lux_memory_category_t payloads;        // copied and owned block data
+    lux_memory_category_t table_entries;   // hash-table entry arrays
+    lux_memory_category_t children_arrays; // per-parent child pointer arrays
+    lux_memory_category_t vote_cache;      // analytics ring
+    lux_memory_category_t voter_state;     // voter registry + dedup bitmaps
+    lux_memory_category_t indexes;         // conflict sets + height index
+    uint64_t total_current;                // sum of the categories above
+} lux_memory_stats_t;
+
+lux_error_t lux_chain_memory_usage(
+    lux_chain_t* chain,
+    lux_memory_stats_t* stats
+);
+
 // Utility functions
 const char* lux_error_string(lux_error_t error);
 const char* lux_engine_type_string(lux_engine_type_t type);
@@ -0,0 +1,510 @@
+// Copyright (C) 2019-2025, Lux Industries Inc. All rights reserved.
+// See the file LICENSE for licensing terms.
+//
+// lux_consensus.hpp — official C++ interface over the C ABI. Header-only and
+// zero-overhead: lux::Chain is a movable RAII owner of lux_chain_t*, batch
+// templates forward directly to the C batch entry points (no per-element
+// virtual dispatch, no allocation), and callback registration stores the
+// callable inline when its captures fit in a small buffer. Requires C++17.
+
+#ifndef LUX_CONSENSUS_HPP
+#define LUX_CONSENSUS_HPP
+
+extern "C" {
+#include "lux_consensus.h"
+}
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// C++20 coroutine support is optional: co_await on block finality compiles
+// only when the implementation provides coroutines, and the rest of the
+// header stays valid C++17 either way.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define LUX_CONSENSUS_HAS_COROUTINES 1
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#endif
+
+namespace lux {
+
+using Config = lux_config_t;
+using Block = lux_block_t;
+using Vote = lux_vote_t;
+using Stats = lux_consensus_stats_t;
+using StatsEx = lux_consensus_stats_ex_t;
+
+// Trivially copyable 32-byte block identifier with constexpr comparison, so
+// IDs can be map keys, compile-time constants, and memcpy'd into lux_block_t.
+struct BlockId {
+    std::array<std::uint8_t, 32> bytes{};
+
+    constexpr BlockId() = default;
+
+    static BlockId copy_from(const std::uint8_t* raw) noexcept {
+        BlockId id;
+        std::memcpy(id.bytes.data(), raw, 32);
+        return id;
+    }
+
+    std::uint8_t* data() noexcept { return bytes.data(); }
+    const std::uint8_t* data() const noexcept { return bytes.data(); }
+
+    constexpr bool operator==(const BlockId& other) const noexcept {
+        for (std::size_t i = 0; i < 32; ++i) {
+            if (bytes[i] != other.bytes[i]) return false;
+        }
+        return true;
+    }
+    constexpr bool operator!=(const BlockId& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+static_assert(std::is_trivially_copyable<BlockId>::value,
+              "BlockId must stay trivially copyable");
+static_assert(sizeof(BlockId) == 32, "BlockId must match the wire size");
+
+namespace detail {
+
+// Type-erased void(const uint8_t*) with a small-buffer store: callables whose
+// state fits kInlineSize bytes (and is nothrow-movable) live inside the
+// holder, so registering a lambda with a couple of captured pointers never
+// touches the heap.
+class DecisionFn {
+public:
+    static constexpr std::size_t kInlineSize = 48;
+
+    DecisionFn() noexcept = default;
+    DecisionFn(const DecisionFn&) = delete;
+    DecisionFn& operator=(const DecisionFn&) = delete;
+
+    DecisionFn(DecisionFn&& other) noexcept { move_from(other); }
+    DecisionFn& operator=(DecisionFn&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    ~DecisionFn() { reset(); }
+
+    template <typename F>
+    void assign(F&& fn) {
+        using Decayed = std::decay_t<F>;
+        reset();
+        if constexpr (sizeof(Decayed) <= kInlineSize &&
+                      alignof(Decayed) <= alignof(std::max_align_t) &&
+                      std::is_nothrow_move_constructible<Decayed>::value) {
+            obj_ = new (buf_) Decayed(std::forward<F>(fn));
+            inline_ = true;
+        } else {
+            obj_ = new Decayed(std::forward<F>(fn));
+            inline_ = false;
+        }
+        invoke_ = [](void* obj, const std::uint8_t* id) {
+            (*static_cast<Decayed*>(obj))(BlockId::copy_from(id));
+        };
+        destroy_ = [](void* obj, bool was_inline) {
+            if (was_inline) {
+                static_cast<Decayed*>(obj)->~Decayed();
+            } else {
+                delete static_cast<Decayed*>(obj);
+            }
+        };
+        move_ = [](void* obj, unsigned char* dst) -> void* {
+            return new (dst) Decayed(std::move(*static_cast<Decayed*>(obj)));
+        };
+    }
+
+    void reset() noexcept {
+        if (obj_) {
+            destroy_(obj_, inline_);
+            obj_ = nullptr;
+        }
+        invoke_ = nullptr;
+        destroy_ = nullptr;
+        move_ = nullptr;
+    }
+
+    bool empty() const noexcept { return obj_ == nullptr; }
+
+    // C trampoline: `user_data` is the holder itself.
+    static void trampoline(const std::uint8_t* block_id, void* user_data) {
+        auto* self = static_cast<DecisionFn*>(user_data);
+        if (self->obj_) {
+            self->invoke_(self->obj_, block_id);
+        }
+    }
+
+private:
+    void move_from(DecisionFn& other) noexcept {
+        if (other.obj_ == nullptr) return;
+        invoke_ = other.invoke_;
+        destroy_ = other.destroy_;
+        move_ = other.move_;
+        inline_ = other.inline_;
+        if (other.inline_) {
+            obj_ = move_(other.obj_, buf_);
+            other.destroy_(other.obj_, true);
+        } else {
+            obj_ = other.obj_;
+        }
+        other.obj_ = nullptr;
+        other.invoke_ = nullptr;
+        other.destroy_ = nullptr;
+        other.move_ = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char buf_[kInlineSize];
+    void* obj_ = nullptr;
+    void (*invoke_)(void*, const std::uint8_t*) = nullptr;
+    void (*destroy_)(void*, bool) = nullptr;
+    void* (*move_)(void*, unsigned char*) = nullptr;
+    bool inline_ = false;
+};
+
+#if LUX_CONSENSUS_HAS_COROUTINES
+
+// Hash-indexed table of suspended finality waiters. Waiter nodes live in the
+// awaiting coroutine's frame (intrusive lists), so parking a waiter costs no
+// allocation and wakeup is O(1) expected: the decision callback hashes the
+// decided ID straight to one bucket. The table is heap-held by the Chain so
+// its address survives moves while the C side points at it.
+class FinalityWaiters {
+public:
+    static constexpr std::size_t kBuckets = 64;
+
+    struct Waiter {
+        BlockId id;
+        std::coroutine_handle<> handle;
+        Waiter* next = nullptr;
+    };
+
+    void set_user_fn(DecisionFn* fn) noexcept { user_fn_ = fn; }
+
+    // Engine delivery-thread entry: unlink every waiter parked on this ID,
+    // forward the decision to the user's callback, then resume the waiters.
+    // Resumption runs on the delivery thread, after the bucket lock is
+    // dropped, so resumed coroutines may await again without deadlock.
+    static void trampoline(const std::uint8_t* block_id, void* user_data) {
+        auto* self = static_cast<FinalityWaiters*>(user_data);
+        Waiter* ready = self->take_matching(BlockId::copy_from(block_id));
+        if (self->user_fn_ && !self->user_fn_->empty()) {
+            DecisionFn::trampoline(block_id, self->user_fn_);
+        }
+        while (ready) {
+            Waiter* next = ready->next;
+            ready->handle.resume();
+            ready = next;
+        }
+    }
+
+    void add(Waiter* w) {
+        Bucket& b = bucket_for(w->id);
+        std::lock_guard<std::mutex> lock(b.lock);
+        w->next = b.head;
+        b.head = w;
+    }
+
+    // Withdraw a parked waiter; returns false if the delivery thread already
+    // claimed it (in which case it is about to be resumed).
+    bool remove(Waiter* w) {
+        Bucket& b = bucket_for(w->id);
+        std::lock_guard<std::mutex> lock(b.lock);
+        for (Waiter** link = &b.head; *link; link = &(*link)->next) {
+            if (*link == w) {
+                *link = w->next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Bucket {
+        std::mutex lock;
+        Waiter* head = nullptr;
+    };
+
+    Bucket& bucket_for(const BlockId& id) noexcept {
+        return buckets_[id.bytes[0] & (kBuckets - 1)];
+    }
+
+    Waiter* take_matching(const BlockId& id) {
+        Bucket& b = bucket_for(id);
+        std::lock_guard<std::mutex> lock(b.lock);
+        Waiter* ready = nullptr;
+        Waiter** link = &b.head;
+        while (*link) {
+            if ((*link)->id == id) {
+                Waiter* w = *link;
+                *link = w->next;
+                w->next = ready;
+                ready = w;
+            } else {
+                link = &(*link)->next;
+            }
+        }
+        return ready;
+    }
+
+    Bucket buckets_[kBuckets];
+    DecisionFn* user_fn_ = nullptr;
+};
+
+#endif // LUX_CONSENSUS_HAS_COROUTINES
+
+} // namespace detail
+
+// Movable owner of a lux_chain_t*. Destruction stops the pipeline and frees
+// the chain; moved-from chains are empty and safe to destroy.
+class Chain {
+public:
+    Chain() noexcept = default;
+
+    explicit Chain(const Config& config) noexcept
+        : handle_(lux_chain_new(&config)) {}
+
+    static Chain with_defaults() noexcept {
+        Chain c;
+        c.handle_ = lux_chain_new_default();
+        return c;
+    }
+
+    // Persistent chain backed by an mmap'd block log (see lux_chain_open)
+    static Chain open(const char* path, const Config* config = nullptr) noexcept {
+        Chain c;
+        c.handle_ = lux_chain_open(path, config);
+        return c;
+    }
+
+    Chain(const Chain&) = delete;
+    Chain& operator=(const Chain&) = delete;
+
+    Chain(Chain&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)),
+          decision_fn_(std::move(other.decision_fn_)) {
+#if LUX_CONSENSUS_HAS_COROUTINES
+        waiters_ = std::move(other.waiters_);
+#endif
+        rebind_callback();
+    }
+
+    Chain& operator=(Chain&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+            decision_fn_ = std::move(other.decision_fn_);
+#if LUX_CONSENSUS_HAS_COROUTINES
+            waiters_ = std::move(other.waiters_);
+#endif
+            rebind_callback();
+        }
+        return *this;
+    }
+
+    ~Chain() { reset(); }
+
+    explicit operator bool() const noexcept { return handle_ != nullptr; }
+    lux_chain_t* get() const noexcept { return handle_; }
+
+    void reset() noexcept {
+        if (handle_) {
+            lux_chain_destroy(handle_);
+            handle_ = nullptr;
+        }
+        decision_fn_.reset();
+#if LUX_CONSENSUS_HAS_COROUTINES
+        waiters_.reset(); // chain destroy stopped delivery, so no racing wakeup
+#endif
+    }
+
+    lux_error_t start() noexcept { return lux_chain_start(handle_); }
+    void stop() noexcept { lux_chain_stop(handle_); }
+
+    lux_error_t add_block(const Block& block) noexcept {
+        return lux_chain_add_block(handle_, &block);
+    }
+
+    lux_error_t add_block_owned(const Block& block, lux_callback_release release,
+                                void* user_data = nullptr) noexcept {
+        return lux_chain_add_block_owned(handle_, &block, release, user_data);
+    }
+
+    // Contiguous range of Block (vector, array, C array, span-alike). Stops
+    // at the first failing element and returns its error.
+    template <typename Range>
+    lux_error_t add_blocks(const Range& blocks) noexcept {
+        const Block* data = std::data(blocks);
+        const std::size_t count = std::size(blocks);
+        for (std::size_t i = 0; i < count; ++i) {
+            lux_error_t err = lux_chain_add_block(handle_, &data[i]);
+            if (err != LUX_SUCCESS) return err;
+        }
+        return LUX_SUCCESS;
+    }
+
+    lux_error_t process_vote(const Vote& vote) noexcept {
+        return lux_consensus_process_vote(handle_, &vote);
+    }
+
+    lux_error_t submit_vote(const Vote& vote) noexcept {
+        return lux_consensus_submit_vote(handle_, &vote);
+    }
+
+    // Contiguous range of Vote, forwarded to the single-lock batch call.
+    // `results`, when non-null, must have room for std::size(votes) entries.
+    template <typename Range>
+    lux_error_t process_votes(const Range& votes,
+                              lux_error_t* results = nullptr) noexcept {
+        return lux_consensus_process_votes(handle_, std::data(votes),
+                                           std::size(votes), results);
+    }
+
+    bool is_accepted(const BlockId& id) const noexcept {
+        bool accepted = false;
+        if (lux_consensus_is_accepted(handle_, id.data(), &accepted) !=
+            LUX_SUCCESS) {
+            return false;
+        }
+        return accepted;
+    }
+
+    BlockId preference() const noexcept {
+        BlockId id;
+        lux_consensus_get_preference(handle_, id.data());
+        return id;
+    }
+
+    Stats stats() const noexcept {
+        Stats s{};
+        lux_consensus_get_stats(handle_, &s);
+        return s;
+    }
+
+    StatsEx stats_ex() const noexcept {
+        StatsEx s{};
+        s.version = LUX_STATS_EX_VERSION;
+        lux_consensus_get_stats_ex(handle_, &s);
+        return s;
+    }
+
+    // Drain up to `max` finalized IDs into `out` (see
+    // lux_consensus_drain_decisions). Returns the number drained.
+    std::size_t drain_decisions(BlockId* out, std::size_t max) noexcept {
+        std::size_t n = 0;
+        lux_consensus_drain_decisions(
+            handle_, max, reinterpret_cast<std::uint8_t*>(out), &n);
+        return n;
+    }
+
+    // Register a decision callback. `fn` is any callable taking a BlockId;
+    // captures up to 48 bytes are stored inline in the Chain, larger ones
+    // fall back to one heap allocation at registration time.
+    template <typename F>
+    lux_error_t on_decision(F&& fn) {
+        decision_fn_.assign(std::forward<F>(fn));
+#if LUX_CONSENSUS_HAS_COROUTINES
+        if (waiters_) {
+            // The waiter trampoline stays installed and forwards to fn
+            waiters_->set_user_fn(&decision_fn_);
+            return lux_consensus_register_decision_callback(
+                handle_, &detail::FinalityWaiters::trampoline, waiters_.get());
+        }
+#endif
+        return lux_consensus_register_decision_callback(
+            handle_, &detail::DecisionFn::trampoline, &decision_fn_);
+    }
+
+    lux_error_t on_verify(lux_callback_verify cb, void* user_data) noexcept {
+        return lux_consensus_register_verify_callback(handle_, cb, user_data);
+    }
+
+#if LUX_CONSENSUS_HAS_COROUTINES
+    // Awaitable returned by finality(). An already-decided block resumes
+    // immediately without suspending; otherwise the coroutine parks in the
+    // waiter table (no thread blocked, no allocation) and resumes on the
+    // engine's delivery thread when the block decides.
+    class FinalityAwaitable {
+    public:
+        FinalityAwaitable(Chain& chain, const BlockId& id) noexcept
+            : chain_(&chain) {
+            waiter_.id = id;
+        }
+
+        bool await_ready() const noexcept {
+            return chain_->is_accepted(waiter_.id);
+        }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            waiter_.handle = h;
+            detail::FinalityWaiters& w = *chain_->waiters_;
+            w.add(&waiter_);
+            // The block may have decided between await_ready and the insert;
+            // re-check and withdraw so a racing decision cannot be missed. If
+            // remove() fails the delivery thread owns the waiter and will
+            // resume it, so we must report "suspended" either way.
+            if (chain_->is_accepted(waiter_.id) && w.remove(&waiter_)) {
+                return false;
+            }
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        Chain* chain_;
+        detail::FinalityWaiters::Waiter waiter_;
+    };
+
+    // co_await chain.finality(id) — see FinalityAwaitable. The Chain must
+    // outlive every suspended waiter, and must not be moved while any
+    // coroutine is suspended on it (the awaitable caches the Chain address).
+    FinalityAwaitable finality(const BlockId& id) {
+        if (!waiters_ && handle_) {
+            waiters_ = std::make_unique<detail::FinalityWaiters>();
+            waiters_->set_user_fn(&decision_fn_);
+            lux_consensus_register_decision_callback(
+                handle_, &detail::FinalityWaiters::trampoline, waiters_.get());
+        }
+        return FinalityAwaitable(*this, id);
+    }
+#endif
+
+private:
+    // The C side holds a pointer to decision_fn_, which moves with the Chain;
+    // re-register after every move so it never dangles.
+    void rebind_callback() noexcept {
+#if LUX_CONSENSUS_HAS_COROUTINES
+        if (handle_ && waiters_) {
+            waiters_->set_user_fn(&decision_fn_);
+            lux_consensus_register_decision_callback(
+                handle_, &detail::FinalityWaiters::trampoline, waiters_.get());
+            return;
+        }
+#endif
+        if (handle_ && !decision_fn_.empty()) {
+            lux_consensus_register_decision_callback(
+                handle_, &detail::DecisionFn::trampoline, &decision_fn_);
+        }
+    }
+
+    lux_chain_t* handle_ = nullptr;
+    detail::DecisionFn decision_fn_;
+#if LUX_CONSENSUS_HAS_COROUTINES
+    std::unique_ptr<detail::FinalityWaiters> waiters_;
+#endif
+};
+
+} // namespace lux
+
+#endif // LUX_CONSENSUS_HPP
@@ -0,0 +1,245 @@
+// Copyright (C) 2019-2025, Lux Industries Inc. All rights reserved.
+// See the file LICENSE for licensing terms.
+//
+// Memory-mapped append-only block log. Accepted blocks are appended as
+// checksummed, length-prefixed records; on restart the whole file is mmap'd
+// and replayed with a single sequential scan — the fixed-size record header
+// is read in place, so reload cost is bounded by memcpy of the payloads, not
+// per-record read(2) calls. The file grows in 4 MiB chunks via ftruncate and
+// is remapped on growth; durability is page-cache based, with one msync on
+// close. A truncated or corrupt tail (e.g. crash mid-append) is detected by
+// the record checksum and the log is clipped back to the last good record.
+// Internal header, included by consensus_engine.c only.
+
+#ifndef LUX_BLOCK_LOG_H
+#define LUX_BLOCK_LOG_H
+
+#include <lux_consensus.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BLOCK_LOG_MAGIC   0x31474C42u  // "BLG1", little-endian
+#define BLOCK_LOG_VERSION 1u
+#define BLOCK_LOG_CHUNK   (4u << 20)   // growth increment
+
+// 16-byte file header at offset 0
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+} block_log_file_header_t;
+
+// Fixed-size record header, followed by data_size payload bytes padded to
+// 8-byte alignment. checksum covers every header field after it plus the
+// payload, so an all-zero region (fresh ftruncate fill) never validates.
+typedef struct {
+    uint32_t data_size;
+    uint32_t checksum;
+    uint64_t height;
+    uint64_t timestamp;
+    uint8_t id[32];
+    uint8_t parent_id[32];
+} block_log_record_t;
+
+typedef struct {
+    int fd;
+    uint8_t* map;
+    size_t map_size;        // bytes mapped (== file size)
+    size_t end;             // append offset
+    pthread_mutex_t lock;
+} block_log_t;
+
+static inline size_t block_log_record_size(uint32_t data_size) {
+    return (sizeof(block_log_record_t) + data_size + 7u) & ~(size_t)7u;
+}
+
+// FNV-1a; cheap, and only guards against torn writes, not adversaries
+static uint32_t block_log_checksum(const block_log_record_t* rec,
+                                   const void* data) {
+    uint32_t h = 0x811C9DC5u;
+    const uint8_t* p = (const uint8_t*)&rec->height;
+    size_t header_rest = sizeof(*rec) - offsetof(block_log_record_t, height);
+    for (size_t i = 0; i < header_rest; i++) {
+        h = (h ^ p[i]) * 0x01000193u;
+    }
+    p = (const uint8_t*)&rec->data_size;
+    for (size_t i = 0; i < sizeof(rec->data_size); i++) {
+        h = (h ^ p[i]) * 0x01000193u;
+    }
+    p = (const uint8_t*)data;
+    for (size_t i = 0; i < rec->data_size; i++) {
+        h = (h ^ p[i]) * 0x01000193u;
+    }
+    return h;
+}
+
+static lux_error_t block_log_map(block_log_t* log, size_t size) {
+    if (log->map) {
+        munmap(log->map, log->map_size);
+        log->map = NULL;
+    }
+    if (ftruncate(log->fd, (off_t)size) != 0) {
+        return LUX_ERROR_INVALID_STATE;
+    }
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     log->fd, 0);
+    if (map == MAP_FAILED) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    log->map = (uint8_t*)map;
+    log->map_size = size;
+    return LUX_SUCCESS;
+}
+
+// Open (creating if needed) the log at path and position the append offset
+// after the last valid record. A bad magic is an error; a bad record just
+// ends the scan, clipping any torn tail.
+static lux_error_t block_log_open(block_log_t* log, const char* path) {
+    memset(log, 0, sizeof(*log));
+    pthread_mutex_init(&log->lock, NULL);
+
+    log->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (log->fd < 0) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    struct stat st;
+    if (fstat(log->fd, &st) != 0) {
+        close(log->fd);
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    bool fresh = file_size < sizeof(block_log_file_header_t);
+    size_t map_size = file_size > BLOCK_LOG_CHUNK ? file_size : BLOCK_LOG_CHUNK;
+
+    lux_error_t err = block_log_map(log, map_size);
+    if (err != LUX_SUCCESS) {
+        close(log->fd);
+        return err;
+    }
+
+    block_log_file_header_t* hdr = (block_log_file_header_t*)log->map;
+    if (fresh) {
+        hdr->magic = BLOCK_LOG_MAGIC;
+        hdr->version = BLOCK_LOG_VERSION;
+        hdr->reserved = 0;
+    } else if (hdr->magic != BLOCK_LOG_MAGIC ||
+               hdr->version != BLOCK_LOG_VERSION) {
+        munmap(log->map, log->map_size);
+        close(log->fd);
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    // Sequential scan to find the end of the valid prefix
+    size_t off = sizeof(block_log_file_header_t);
+    while (off + sizeof(block_log_record_t) <= file_size) {
+        const block_log_record_t* rec =
+            (const block_log_record_t*)(log->map + off);
+        size_t rec_size = block_log_record_size(rec->data_size);
+        if (off + rec_size > file_size) {
+            break; // truncated tail
+        }
+        if (block_log_checksum(rec, rec + 1) != rec->checksum) {
+            break; // torn or corrupt record
+        }
+        off += rec_size;
+    }
+    log->end = off;
+    return LUX_SUCCESS;
+}
+
+// Append one accepted block. Thread-safe; remaps on growth, so callers must
+// not hold pointers into the mapping across appends.
+static lux_error_t block_log_append(block_log_t* log, const uint8_t* id,
+                                    const uint8_t* parent_id, uint64_t height,
+                                    uint64_t timestamp, const void* data,
+                                    size_t data_size) {
+    if (data_size > UINT32_MAX) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    pthread_mutex_lock(&log->lock);
+
+    size_t rec_size = block_log_record_size((uint32_t)data_size);
+    if (log->end + rec_size > log->map_size) {
+        size_t new_size = log->map_size;
+        while (log->end + rec_size > new_size) {
+            new_size += BLOCK_LOG_CHUNK;
+        }
+        lux_error_t err = block_log_map(log, new_size);
+        if (err != LUX_SUCCESS) {
+            pthread_mutex_unlock(&log->lock);
+            return err;
+        }
+    }
+
+    block_log_record_t* rec = (block_log_record_t*)(log->map + log->end);
+    rec->data_size = (uint32_t)data_size;
+    rec->height = height;
+    rec->timestamp = timestamp;
+    memcpy(rec->id, id, 32);
+    memcpy(rec->parent_id, parent_id, 32);
+    if (data_size > 0) {
+        memcpy(rec + 1, data, data_size);
+    }
+    // Checksum last, so a crash mid-memcpy leaves an invalid record that the
+    // open-time scan clips off
+    rec->checksum = block_log_checksum(rec, rec + 1);
+    log->end += rec_size;
+
+    pthread_mutex_unlock(&log->lock);
+    return LUX_SUCCESS;
+}
+
+// Iterate the valid prefix in append order. The lux_block_t handed to the
+// callback points into the mapping — valid only for the duration of the call.
+typedef lux_error_t (*block_log_replay_fn)(const lux_block_t* block,
+                                           void* ctx);
+
+static lux_error_t block_log_replay(block_log_t* log, block_log_replay_fn fn,
+                                    void* ctx) {
+    size_t off = sizeof(block_log_file_header_t);
+    while (off < log->end) {
+        const block_log_record_t* rec =
+            (const block_log_record_t*)(log->map + off);
+        lux_block_t block;
+        memcpy(block.id, rec->id, 32);
+        memcpy(block.parent_id, rec->parent_id, 32);
+        block.height = rec->height;
+        block.timestamp = rec->timestamp;
+        block.data = rec->data_size > 0 ? (void*)(rec + 1) : NULL;
+        block.data_size = rec->data_size;
+        lux_error_t err = fn(&block, ctx);
+        if (err != LUX_SUCCESS) {
+            return err;
+        }
+        off += block_log_record_size(rec->data_size);
+    }
+    return LUX_SUCCESS;
+}
+
+static void block_log_close(block_log_t* log) {
+    if (log->map) {
+        msync(log->map, log->end, MS_SYNC);
+        // Shrink the file back to its used length so restarts scan no slack
+        if (ftruncate(log->fd, (off_t)log->end) == 0) {
+            // best effort; a zero-filled tail is clipped at open anyway
+        }
+        munmap(log->map, log->map_size);
+        log->map = NULL;
+    }
+    if (log->fd >= 0) {
+        close(log->fd);
+        log->fd = -1;
+    }
+    pthread_mutex_destroy(&log->lock);
+}
+
+#endif // LUX_BLOCK_LOG_H
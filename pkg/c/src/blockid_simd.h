@@ -0,0 +1,180 @@
+// Copyright (C) 2019-2025, Lux Industries Inc. All rights reserved.
+// See the file LICENSE for licensing terms.
+//
+// SIMD kernels for 32-byte block-ID hashing and comparison. A block ID fits
+// in one AVX2 register (or two SSE2/NEON registers), so equality is a couple
+// of vector compares and hashing a short mixing sequence — these run on every
+// vote, block add, and acceptance query, so they are the hottest few
+// instructions in the engine. x86 picks AVX2 at runtime when available and
+// falls back to SSE2 (baseline on x86-64); ARM uses NEON; everything else
+// gets portable scalar code. Internal header, included by consensus_engine.c
+// only.
+
+#ifndef LUX_BLOCKID_SIMD_H
+#define LUX_BLOCKID_SIMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define BLOCKID_HAVE_X86 1
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BLOCKID_HAVE_NEON 1
+#endif
+
+// ---------------------------------------------------------------------------
+// Equality
+// ---------------------------------------------------------------------------
+
+__attribute__((unused)) // fallback; only dispatched on non-SIMD targets
+static bool blockid_equal_scalar(const uint8_t* a, const uint8_t* b) {
+    // Compare as four 64-bit lanes; memcpy keeps it alignment-safe and
+    // compiles to plain loads.
+    uint64_t la[4], lb[4];
+    memcpy(la, a, 32);
+    memcpy(lb, b, 32);
+    return ((la[0] ^ lb[0]) | (la[1] ^ lb[1]) |
+            (la[2] ^ lb[2]) | (la[3] ^ lb[3])) == 0;
+}
+
+#ifdef BLOCKID_HAVE_X86
+
+static bool blockid_equal_sse2(const uint8_t* a, const uint8_t* b) {
+    __m128i a0 = _mm_loadu_si128((const __m128i*)a);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)(a + 16));
+    __m128i b0 = _mm_loadu_si128((const __m128i*)b);
+    __m128i b1 = _mm_loadu_si128((const __m128i*)(b + 16));
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a0, b0), _mm_cmpeq_epi8(a1, b1));
+    return _mm_movemask_epi8(eq) == 0xFFFF;
+}
+
+__attribute__((target("avx2")))
+static bool blockid_equal_avx2(const uint8_t* a, const uint8_t* b) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)) == -1;
+}
+
+#endif // BLOCKID_HAVE_X86
+
+#ifdef BLOCKID_HAVE_NEON
+
+static bool blockid_equal_neon(const uint8_t* a, const uint8_t* b) {
+    uint8x16_t a0 = vld1q_u8(a);
+    uint8x16_t a1 = vld1q_u8(a + 16);
+    uint8x16_t b0 = vld1q_u8(b);
+    uint8x16_t b1 = vld1q_u8(b + 16);
+    uint8x16_t ne = vorrq_u8(veorq_u8(a0, b0), veorq_u8(a1, b1));
+    return vmaxvq_u8(ne) == 0;
+}
+
+#endif // BLOCKID_HAVE_NEON
+
+// ---------------------------------------------------------------------------
+// Hashing
+// ---------------------------------------------------------------------------
+
+static inline uint64_t blockid_mix64(uint64_t x) {
+    // xxhash/splitmix-style avalanche
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static uint32_t blockid_hash_scalar(const uint8_t* id) {
+    uint64_t lanes[4];
+    memcpy(lanes, id, 32);
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    h = blockid_mix64(h ^ lanes[0]);
+    h = blockid_mix64(h ^ lanes[1]);
+    h = blockid_mix64(h ^ lanes[2]);
+    h = blockid_mix64(h ^ lanes[3]);
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+#ifdef BLOCKID_HAVE_X86
+
+__attribute__((target("avx2")))
+static uint32_t blockid_hash_avx2(const uint8_t* id) {
+    // Treat the ID as eight 32-bit lanes, multiply-mix them in one register,
+    // then fold horizontally. Distribution only needs to be good enough for
+    // the block table; equality is always exact.
+    const __m256i mul = _mm256_set_epi32(
+        (int)0x85EBCA6B, (int)0xC2B2AE35, (int)0x27D4EB2F, (int)0x9E3779B1,
+        (int)0x85EBCA6B, (int)0xC2B2AE35, (int)0x27D4EB2F, (int)0x9E3779B1);
+    __m256i v = _mm256_loadu_si256((const __m256i*)id);
+    v = _mm256_mullo_epi32(v, mul);
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 15));
+    v = _mm256_mullo_epi32(v, mul);
+
+    __m128i lo = _mm256_castsi256_si128(v);
+    __m128i hi = _mm256_extracti128_si256(v, 1);
+    __m128i x = _mm_xor_si128(lo, hi);
+    x = _mm_xor_si128(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_xor_si128(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t h = (uint32_t)_mm_cvtsi128_si32(x);
+    // Final scalar avalanche so low bits (shard selector) are well mixed.
+    h ^= h >> 16; h *= 0x85EBCA6BU; h ^= h >> 13;
+    return h;
+}
+
+#endif // BLOCKID_HAVE_X86
+
+// ---------------------------------------------------------------------------
+// Runtime dispatch. Resolved on first call, then direct through a function
+// pointer; single-TU statics, so no cross-object linkage concerns.
+// ---------------------------------------------------------------------------
+
+typedef bool (*blockid_eq_fn)(const uint8_t*, const uint8_t*);
+typedef uint32_t (*blockid_hash_fn)(const uint8_t*);
+
+static bool blockid_equal_resolve(const uint8_t* a, const uint8_t* b);
+static uint32_t blockid_hash_resolve(const uint8_t* id);
+
+static blockid_eq_fn blockid_eq_impl = blockid_equal_resolve;
+static blockid_hash_fn blockid_hash_impl = blockid_hash_resolve;
+
+static void blockid_dispatch_init(void) {
+#if defined(BLOCKID_HAVE_X86)
+    if (__builtin_cpu_supports("avx2")) {
+        blockid_eq_impl = blockid_equal_avx2;
+        blockid_hash_impl = blockid_hash_avx2;
+    } else {
+        blockid_eq_impl = blockid_equal_sse2;
+        blockid_hash_impl = blockid_hash_scalar;
+    }
+#elif defined(BLOCKID_HAVE_NEON)
+    blockid_eq_impl = blockid_equal_neon;
+    blockid_hash_impl = blockid_hash_scalar;
+#else
+    blockid_eq_impl = blockid_equal_scalar;
+    blockid_hash_impl = blockid_hash_scalar;
+#endif
+}
+
+static bool blockid_equal_resolve(const uint8_t* a, const uint8_t* b) {
+    blockid_dispatch_init();
+    return blockid_eq_impl(a, b);
+}
+
+static uint32_t blockid_hash_resolve(const uint8_t* id) {
+    blockid_dispatch_init();
+    return blockid_hash_impl(id);
+}
+
+// Public (intra-library) entry points.
+static inline bool blockid_equal(const uint8_t* a, const uint8_t* b) {
+    return blockid_eq_impl(a, b);
+}
+
+static inline uint32_t blockid_hash(const uint8_t* id) {
+    return blockid_hash_impl(id);
+}
+
+#endif // LUX_BLOCKID_SIMD_H
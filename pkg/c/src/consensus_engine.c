@@ -2,10 +2,16 @@
 // See the file LICENSE for licensing terms.
 
 #include "../include/lux_consensus.h"
+#include "blockid_simd.h"
+#include "block_log.h"
+#include "vote_journal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <pthread.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <unistd.h>
 #include <time.h>
 
 // Internal data structures optimized for C
@@ -19,47 +25,634 @@ typedef struct block_node {
     
     // Consensus state
     // [C-010] Use uint64_t to prevent overflow at 2^32 votes
-    uint64_t preference_count;
-    uint64_t confidence_count;
-    bool is_accepted;
-    bool is_rejected;
-    bool is_processing;
+    // Counters and decision flags are atomics so vote threads can count and
+    // check state under only their table-shard lock; the tree mutex is taken
+    // solely for the decision transition itself.
+    _Atomic uint64_t preference_count;
+    _Atomic uint64_t confidence_count;
+    _Atomic bool is_accepted;
+    _Atomic bool is_rejected;
+    bool decision_reported;    // queued for delivery; guarded by engine->mutex
+    _Atomic bool is_processing;
     
     // Performance optimization
     uint64_t last_poll_time;
     uint32_t poll_count;
+    uint64_t added_ns;  // CLOCK_MONOTONIC at add time, for decision latency
+
+    // Payload ownership. data_copied marks an engine-owned copy (freed with
+    // free()); data_release marks a caller buffer handed over zero-copy via
+    // lux_chain_add_block_owned and is invoked exactly once at teardown.
+    bool data_copied;
+    lux_callback_release data_release;
+    void* data_release_ctx;
+
+    // Conflict-set membership: competitors sharing (parent, height). idx is
+    // the node's slot in the set's member array, for O(1) swap-removal.
+    struct conflict_set* conflict_set;
+    size_t conflict_idx;
+
+    // Voter bitmaps for duplicate suppression: 2 * VOTER_WORDS words
+    // (preference plane, then confidence), allocated on the node's first
+    // vote and CAS-published so concurrent voters agree on one buffer.
+    _Atomic(uint64_t*) voter_bits;
+
+    // Votes journaled for this node while it was undecided; credited back to
+    // the journal's outstanding count when the node decides.
+    _Atomic uint32_t journaled_votes;
 } block_node_t;
 
+// Conflict set: the undecided blocks competing at one (parent, height).
+// Kept as a compact array so acceptance rejects the whole set with one
+// cache-friendly sweep instead of scanning the parent's full child list.
+// All mutation happens under engine->mutex (the tree lock).
+typedef struct conflict_set {
+    block_node_t* parent;
+    uint64_t height;
+    block_node_t** members;
+    size_t count;
+    size_t capacity;
+    struct conflict_set* next;  // bucket chain in the per-chain index
+} conflict_set_t;
+
+#define CONFLICT_BUCKET_COUNT 256
+
+// Validator-set bound shared by polling and the voter registry
+#define LAT_HIST_SUB_BITS 5
+#define LAT_HIST_SUB (1u << LAT_HIST_SUB_BITS)
+#define LAT_HIST_BUCKETS ((64 - LAT_HIST_SUB_BITS) * LAT_HIST_SUB)
+
+#define LUX_MAX_VALIDATORS 10000
+
+// Per-node voter bitmaps: one bit per registered validator, separate planes
+// for preference and confidence votes
+#define VOTER_WORDS ((LUX_MAX_VALIDATORS + 63) / 64)
+
+// Fixed-capacity open-addressed voter registry (power of two, load factor
+// stays under 75% at LUX_MAX_VALIDATORS). Entries never move, so readers can
+// probe lock-free against release-published slots.
+#define VOTER_REG_CAPACITY 16384
+
+typedef struct {
+    uint8_t voter_id[32];
+    uint32_t index;          // dense index assigned at registration
+    _Atomic uint32_t state;  // 0 = empty, 1 = published
+} voter_entry_t;
+
+// One cached vote record. Records live contiguously in a fixed-capacity ring
+// (see lux_chain.vote_ring); the oldest record is overwritten when full, so
+// eviction costs nothing and insertion is a single indexed store.
 typedef struct vote_cache {
     uint8_t voter_id[32];
     uint8_t block_id[32];
     uint64_t timestamp;
-    struct vote_cache* next;
 } vote_cache_t;
 
-// Hash table for fast block lookup
-#define HASH_TABLE_SIZE 1024
+#define VOTE_CACHE_DEFAULT_CAPACITY 10000
+
+// Slab allocator for the engine's fixed-size structs (block nodes). Objects
+// are carved from chunk allocations and recycled through a freelist, so
+// steady-state allocation is O(1) with no libc malloc call, and teardown
+// frees whole chunks instead of walking millions of objects.
+#define SLAB_CHUNK_OBJECTS 1024
+
+typedef struct slab_chunk {
+    struct slab_chunk* next;
+    // SLAB_CHUNK_OBJECTS objects of obj_size bytes follow
+} slab_chunk_t;
+
+typedef struct slab_pool {
+    size_t obj_size;       // at least sizeof(void*), for freelist links
+    slab_chunk_t* chunks;  // every chunk ever allocated, for bulk teardown
+    void* free_list;       // recycled objects, linked through their first word
+    _Atomic uint64_t chunk_count; // for memory accounting; chunks never shrink
+    pthread_mutex_t lock;
+} slab_pool_t;
+
+static void slab_init(slab_pool_t* pool, size_t obj_size) {
+    pool->obj_size = obj_size < sizeof(void*) ? sizeof(void*) : obj_size;
+    pool->chunks = NULL;
+    pool->free_list = NULL;
+    pthread_mutex_init(&pool->lock, NULL);
+}
+
+// Allocate one chunk and thread its objects onto the freelist. Caller must
+// hold pool->lock.
+static bool slab_add_chunk(slab_pool_t* pool) {
+    slab_chunk_t* chunk = (slab_chunk_t*)malloc(
+        sizeof(slab_chunk_t) + SLAB_CHUNK_OBJECTS * pool->obj_size);
+    if (!chunk) {
+        return false;
+    }
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+    atomic_fetch_add_explicit(&pool->chunk_count, 1, memory_order_relaxed);
+
+    uint8_t* base = (uint8_t*)(chunk + 1);
+    for (size_t i = 0; i < SLAB_CHUNK_OBJECTS; i++) {
+        void* obj = base + i * pool->obj_size;
+        *(void**)obj = pool->free_list;
+        pool->free_list = obj;
+    }
+    return true;
+}
+
+// Preallocate chunks for at least `count` objects, so the first `count`
+// slab_alloc calls never touch libc malloc. Best-effort: stops at OOM and
+// the pool simply stays partly lazy.
+static void slab_reserve(slab_pool_t* pool, size_t count) {
+    size_t chunks = (count + SLAB_CHUNK_OBJECTS - 1) / SLAB_CHUNK_OBJECTS;
+    pthread_mutex_lock(&pool->lock);
+    for (size_t i = 0; i < chunks; i++) {
+        if (!slab_add_chunk(pool)) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Allocate one zeroed object from the pool.
+static void* slab_alloc(slab_pool_t* pool) {
+    pthread_mutex_lock(&pool->lock);
+
+    if (!pool->free_list && !slab_add_chunk(pool)) {
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+
+    void* obj = pool->free_list;
+    pool->free_list = *(void**)obj;
+    pthread_mutex_unlock(&pool->lock);
+
+    memset(obj, 0, pool->obj_size);
+    return obj;
+}
+
+static void slab_free(slab_pool_t* pool, void* obj) {
+    if (!obj) return;
+    pthread_mutex_lock(&pool->lock);
+    *(void**)obj = pool->free_list;
+    pool->free_list = obj;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Bulk teardown: frees every chunk, and with it every object ever handed
+// out, without walking individual objects.
+static void slab_destroy(slab_pool_t* pool) {
+    slab_chunk_t* chunk = pool->chunks;
+    while (chunk) {
+        slab_chunk_t* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->free_list = NULL;
+    pthread_mutex_destroy(&pool->lock);
+}
+
+// Memory accounting: one counter pair per allocation category. Additions
+// also maintain the high-water mark with a CAS loop; subtraction is a
+// single relaxed decrement.
+typedef struct {
+    _Atomic uint64_t current;
+    _Atomic uint64_t peak;
+} mem_counter_t;
+
+static void mem_add(mem_counter_t* c, uint64_t bytes) {
+    uint64_t now = atomic_fetch_add_explicit(&c->current, bytes,
+                                             memory_order_relaxed) + bytes;
+    uint64_t peak = atomic_load_explicit(&c->peak, memory_order_relaxed);
+    while (now > peak &&
+           !atomic_compare_exchange_weak_explicit(&c->peak, &peak, now,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+static void mem_sub(mem_counter_t* c, uint64_t bytes) {
+    atomic_fetch_sub_explicit(&c->current, bytes, memory_order_relaxed);
+}
+
+// Lock-free bounded MPSC queue for the asynchronous vote pipeline (Vyukov
+// bounded-MPMC scheme, used here with a single consumer). Producers claim a
+// cell with one fetch_add and publish it with a release store on the cell's
+// sequence number; no locks, no allocation per vote.
+#define VOTE_QUEUE_CAPACITY 8192 // power of two
+
+typedef struct vote_queue_cell {
+    _Atomic size_t seq;
+    lux_vote_t vote;
+} vote_queue_cell_t;
+
+typedef struct vote_queue {
+    vote_queue_cell_t* cells; // capacity cells, allocated at pipeline start
+    size_t capacity;
+    _Atomic size_t enqueue_pos;
+    _Atomic size_t dequeue_pos;
+} vote_queue_t;
+
+static lux_error_t vote_queue_init(vote_queue_t* q, size_t capacity) {
+    q->cells = (vote_queue_cell_t*)malloc(capacity * sizeof(vote_queue_cell_t));
+    if (!q->cells) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    q->capacity = capacity;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_store_explicit(&q->cells[i].seq, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&q->enqueue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->dequeue_pos, 0, memory_order_relaxed);
+    return LUX_SUCCESS;
+}
+
+static void vote_queue_free(vote_queue_t* q) {
+    free(q->cells);
+    q->cells = NULL;
+}
+
+// Multi-producer push. Returns false when the queue is full.
+static bool vote_queue_push(vote_queue_t* q, const lux_vote_t* vote) {
+    size_t mask = q->capacity - 1;
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        vote_queue_cell_t* cell = &q->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->vote = *vote;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+// Single-consumer batch pop. Returns the number of votes drained.
+static size_t vote_queue_pop_batch(vote_queue_t* q, lux_vote_t* out, size_t max) {
+    size_t mask = q->capacity - 1;
+    size_t n = 0;
+
+    while (n < max) {
+        size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        vote_queue_cell_t* cell = &q->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+            break; // empty
+        }
+        out[n++] = cell->vote;
+        atomic_store_explicit(&cell->seq, pos + q->capacity, memory_order_release);
+        atomic_store_explicit(&q->dequeue_pos, pos + 1, memory_order_relaxed);
+    }
+    return n;
+}
+
+// Ready-decision queue: block IDs whose decision has been reached but whose
+// user-visible delivery (decision callback or lux_consensus_drain_decisions)
+// has not happened yet. Same lock-free bounded ring as the vote queue; a
+// mutex-guarded overflow list absorbs the rare case of more undelivered
+// decisions than ring capacity, with a flag keeping FIFO order intact.
+#define DECISION_QUEUE_CAPACITY 8192 // power of two
+
+typedef struct decision_cell {
+    _Atomic size_t seq;
+    uint8_t block_id[32];
+} decision_cell_t;
+
+typedef struct decision_queue {
+    decision_cell_t* cells;
+    size_t capacity;
+    _Atomic size_t enqueue_pos;
+    _Atomic size_t dequeue_pos;
+
+    // Overflow path (rare): used whenever the ring is full, and until the
+    // overflow list has fully drained so ordering is preserved.
+    _Atomic bool overflow_active;
+    pthread_mutex_t overflow_lock;
+    uint8_t* overflow_ids;     // count * 32 bytes
+    size_t overflow_count;
+    size_t overflow_capacity;
+    size_t overflow_read;      // next index to hand out
+} decision_queue_t;
+
+static lux_error_t decision_queue_init(decision_queue_t* q) {
+    q->cells = (decision_cell_t*)malloc(DECISION_QUEUE_CAPACITY * sizeof(decision_cell_t));
+    if (!q->cells) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    q->capacity = DECISION_QUEUE_CAPACITY;
+    for (size_t i = 0; i < q->capacity; i++) {
+        atomic_store_explicit(&q->cells[i].seq, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&q->enqueue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->dequeue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&q->overflow_active, false, memory_order_relaxed);
+    pthread_mutex_init(&q->overflow_lock, NULL);
+    q->overflow_ids = NULL;
+    q->overflow_count = 0;
+    q->overflow_capacity = 0;
+    q->overflow_read = 0;
+    return LUX_SUCCESS;
+}
+
+static void decision_queue_free(decision_queue_t* q) {
+    free(q->cells);
+    q->cells = NULL;
+    free(q->overflow_ids);
+    q->overflow_ids = NULL;
+    pthread_mutex_destroy(&q->overflow_lock);
+}
+
+// Engine event ring: fixed-size binary records (type + block id + u64
+// payload) in the same Vyukov bounded ring used by the vote queue. Several
+// engine paths emit (tree mutex, cache mutex, prune), so the producer side
+// is multi-producer; the consumer contract is single-threaded polling.
+// When the ring is full the event is dropped and counted; the drop count
+// rides out on the next record that does fit, so the consumer knows the
+// gap size without the producer ever blocking.
+#define EVENT_RING_CAPACITY 1024 // power of two
+
+typedef struct event_cell {
+    _Atomic size_t seq;
+    lux_event_t event;
+} event_cell_t;
+
+typedef struct event_ring {
+    event_cell_t* cells;
+    _Atomic size_t enqueue_pos;
+    _Atomic size_t dequeue_pos;
+    _Atomic uint32_t dropped; // overflow since the last emitted record
+} event_ring_t;
+
+static lux_error_t event_ring_init(event_ring_t* r) {
+    r->cells = (event_cell_t*)malloc(EVENT_RING_CAPACITY * sizeof(event_cell_t));
+    if (!r->cells) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < EVENT_RING_CAPACITY; i++) {
+        atomic_store_explicit(&r->cells[i].seq, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&r->enqueue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->dequeue_pos, 0, memory_order_relaxed);
+    atomic_store_explicit(&r->dropped, 0, memory_order_relaxed);
+    return LUX_SUCCESS;
+}
+
+static void event_ring_emit(event_ring_t* r, uint32_t type,
+                            const uint8_t* block_id, uint64_t payload) {
+    if (!r->cells) {
+        return;
+    }
+    size_t mask = EVENT_RING_CAPACITY - 1;
+    size_t pos = atomic_load_explicit(&r->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        event_cell_t* cell = &r->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &r->enqueue_pos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                cell->event.type = type;
+                cell->event.dropped =
+                    atomic_exchange_explicit(&r->dropped, 0,
+                                             memory_order_relaxed);
+                if (block_id) {
+                    memcpy(cell->event.block_id, block_id, 32);
+                } else {
+                    memset(cell->event.block_id, 0, 32);
+                }
+                cell->event.payload = payload;
+                atomic_store_explicit(&cell->seq, pos + 1,
+                                      memory_order_release);
+                return;
+            }
+        } else if (dif < 0) {
+            // Full: drop, and make the loss visible on the next record.
+            atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            pos = atomic_load_explicit(&r->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static size_t event_ring_poll(event_ring_t* r, lux_event_t* out, size_t max) {
+    if (!r->cells) {
+        return 0;
+    }
+    size_t mask = EVENT_RING_CAPACITY - 1;
+    size_t n = 0;
+
+    while (n < max) {
+        size_t pos = atomic_load_explicit(&r->dequeue_pos, memory_order_relaxed);
+        event_cell_t* cell = &r->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0) {
+            break; // empty
+        }
+        out[n++] = cell->event;
+        atomic_store_explicit(&cell->seq, pos + EVENT_RING_CAPACITY,
+                              memory_order_release);
+        atomic_store_explicit(&r->dequeue_pos, pos + 1, memory_order_relaxed);
+    }
+    return n;
+}
+
+static void event_ring_free(event_ring_t* r) {
+    free(r->cells);
+    r->cells = NULL;
+}
+
+static bool decision_ring_push(decision_queue_t* q, const uint8_t* block_id) {
+    size_t mask = q->capacity - 1;
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        decision_cell_t* cell = &q->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                memcpy(cell->block_id, block_id, 32);
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static bool decision_ring_pop(decision_queue_t* q, uint8_t* block_id_out) {
+    size_t mask = q->capacity - 1;
+
+    for (;;) {
+        size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        decision_cell_t* cell = &q->cells[pos & mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff < 0) {
+            return false; // empty
+        }
+        if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            memcpy(block_id_out, cell->block_id, 32);
+            atomic_store_explicit(&cell->seq, pos + q->capacity, memory_order_release);
+            return true;
+        }
+    }
+}
+
+// Append to the mutex-guarded overflow list (rare slow path).
+static void decision_overflow_push(decision_queue_t* q, const uint8_t* block_id) {
+    pthread_mutex_lock(&q->overflow_lock);
+    if (q->overflow_count == q->overflow_capacity) {
+        size_t new_capacity = q->overflow_capacity ? q->overflow_capacity * 2 : 256;
+        uint8_t* grown = (uint8_t*)realloc(q->overflow_ids, new_capacity * 32);
+        if (!grown) {
+            // Decision delivery must not be lost; spin until a consumer
+            // makes room in the ring instead of dropping.
+            pthread_mutex_unlock(&q->overflow_lock);
+            while (!decision_ring_push(q, block_id)) {
+                sched_yield();
+            }
+            return;
+        }
+        q->overflow_ids = grown;
+        q->overflow_capacity = new_capacity;
+    }
+    memcpy(q->overflow_ids + q->overflow_count * 32, block_id, 32);
+    q->overflow_count++;
+    atomic_store_explicit(&q->overflow_active, true, memory_order_release);
+    pthread_mutex_unlock(&q->overflow_lock);
+}
+
+static void decision_queue_push(decision_queue_t* q, const uint8_t* block_id) {
+    // Once the overflow list is active, everything routes through it until
+    // it drains, so delivery order stays FIFO.
+    if (atomic_load_explicit(&q->overflow_active, memory_order_acquire) ||
+        !decision_ring_push(q, block_id)) {
+        decision_overflow_push(q, block_id);
+    }
+}
+
+// Cheap emptiness probe for the delivery handoff: a push always advances
+// enqueue_pos or raises overflow_active, so "nonempty" is never missed.
+static bool decision_queue_nonempty(decision_queue_t* q) {
+    return atomic_load_explicit(&q->enqueue_pos, memory_order_acquire) !=
+               atomic_load_explicit(&q->dequeue_pos, memory_order_acquire) ||
+           atomic_load_explicit(&q->overflow_active, memory_order_acquire);
+}
+
+static bool decision_queue_pop(decision_queue_t* q, uint8_t* block_id_out) {
+    if (decision_ring_pop(q, block_id_out)) {
+        return true;
+    }
+    if (!atomic_load_explicit(&q->overflow_active, memory_order_acquire)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&q->overflow_lock);
+    bool got = false;
+    if (q->overflow_read < q->overflow_count) {
+        memcpy(block_id_out, q->overflow_ids + q->overflow_read * 32, 32);
+        q->overflow_read++;
+        got = true;
+    }
+    if (q->overflow_read >= q->overflow_count) {
+        q->overflow_count = 0;
+        q->overflow_read = 0;
+        atomic_store_explicit(&q->overflow_active, false, memory_order_release);
+    }
+    pthread_mutex_unlock(&q->overflow_lock);
+    return got;
+}
+
+// Hash table for fast block lookup. The table is sharded: each shard owns its
+// own lock, so votes and lookups for unrelated blocks proceed in parallel
+// instead of serializing on the engine mutex. Within a shard the entries live
+// inline in a flat robin-hood open-addressing array — no per-entry chain
+// nodes, no pointer chases into cold memory — and the array doubles when the
+// load factor crosses 75%, so probe lengths stay short at any block count.
+#define TABLE_SHARD_COUNT 64        // power of two
+#define SHARD_INITIAL_CAPACITY 16   // slots per shard (64 * 16 = 1024 to start)
 
-typedef struct hash_entry {
+typedef struct table_entry {
     uint8_t block_id[32];
-    block_node_t* node;
-    struct hash_entry* next;
-} hash_entry_t;
+    block_node_t* node;   // NULL marks an empty slot
+    uint32_t hash;        // cached full hash, avoids rehash on growth
+    uint32_t psl;         // probe sequence length (distance from home slot)
+} table_entry_t;
+
+typedef struct table_shard {
+    table_entry_t* entries; // flat array, capacity slots, allocated lazily
+    size_t capacity;        // power of two
+    size_t count;
+    pthread_mutex_t lock;
+    // Seqlock over the entries array: writers bump to odd before mutating
+    // under the lock and back to even after, so lock-free readers can
+    // detect any insert, removal, or growth that raced with their probe.
+    _Atomic uint64_t version;
+    // Entry arrays replaced by growth are parked here instead of freed, so
+    // a lock-free reader racing a grow never dereferences unmapped memory.
+    // Growth is geometric, so the parked arrays total less than the live
+    // one; everything is released in the destroy path.
+    struct retired_entries* retired;
+} table_shard_t;
+
+typedef struct retired_entries {
+    table_entry_t* entries;
+    struct retired_entries* next;
+} retired_entries_t;
 
 struct lux_chain {
     lux_config_t config;
-    
+
     // Block storage
-    hash_entry_t* block_table[HASH_TABLE_SIZE];
+    table_shard_t block_table[TABLE_SHARD_COUNT];
     block_node_t* genesis_block;
     block_node_t* preferred_block;
-    
-    // Vote tracking
-    vote_cache_t* vote_cache;
-    size_t vote_cache_size;
-    
-    // Thread safety
+
+    // Seqlock'd copy of the preferred block's ID: readers of
+    // get_preference/poll_ex copy 32 bytes between two even version reads
+    // instead of taking any lock. Written only under engine->mutex.
+    _Atomic uint64_t pref_seq;
+    uint8_t pref_id[32];
+
+    // Highest accepted height, maintained at decision time (CAS max, so
+    // the concurrent direct-add path and the voted path both fold in).
+    _Atomic uint64_t finalized_height;
+
+    // Vote tracking: fixed-capacity ring of recent votes, overwrite-oldest.
+    vote_cache_t* vote_ring;   // allocated lazily, capacity records
+    size_t vote_ring_capacity; // from config.vote_cache_capacity, or default
+    size_t vote_ring_head;     // next slot to write
+    size_t vote_ring_count;    // live records, saturates at capacity
+
+    // Slab pool for block nodes
+    slab_pool_t node_pool;
+
+    // Thread safety: `mutex` guards the block tree (parent/children links,
+    // decision transitions, preferred_block, block stats); each table shard
+    // and the vote cache have their own locks.
     pthread_mutex_t mutex;
+    pthread_mutex_t cache_mutex;
     pthread_rwlock_t rwlock;
     
     // Callbacks
@@ -71,360 +664,1830 @@ struct lux_chain {
     // Statistics
     lux_consensus_stats_t stats;
     uint64_t start_time;
+
+    // Voter registry: 32-byte voter IDs mapped once to dense indices.
+    // Readers probe lock-free; registration serializes on voter_mutex.
+    _Atomic(voter_entry_t*) voter_reg;
+    uint32_t voter_count;
+    pthread_mutex_t voter_mutex;
+
+    // Conflict-set index keyed by (parent, height); guarded by the tree
+    // mutex like the rest of the block tree
+    conflict_set_t* conflict_buckets[CONFLICT_BUCKET_COUNT];
+
+    // Poll sampling state: per-chain PRNG plus index scratch so a sampling
+    // round is allocation-free. Guarded by poll_mutex, not the tree mutex.
+    pthread_mutex_t poll_mutex;
+    uint64_t prng_state[4];
+    uint32_t* poll_scratch;          // index pool for partial Fisher-Yates
+    size_t poll_scratch_capacity;
+    uint32_t* poll_sampled;          // engine-internal result buffer
+    size_t poll_sampled_capacity;
+
+    // Hot-path instrumentation (relaxed atomics; snapshot via
+    // lux_consensus_get_stats_ex). Decision latency fields are plain
+    // because process_decision updates them under the tree mutex.
+    _Atomic uint64_t table_lookups;
+    _Atomic uint64_t probe_hist[LUX_PROBE_HIST_BUCKETS];
+    _Atomic uint64_t tree_lock_wait_ns;
+    _Atomic uint64_t tree_lock_acquisitions;
+    _Atomic uint64_t cache_lock_wait_ns;
+    _Atomic uint64_t cache_lock_acquisitions;
+    _Atomic uint64_t vote_cache_evictions;
+    _Atomic uint64_t children_reallocs;
+    uint64_t decisions_measured;
+    uint64_t decision_latency_total_ns;
+    uint64_t decision_latency_max_ns;
+
+    // Log-linear decision-latency histogram (same bucketing as the
+    // benchmark harness): LAT_HIST_SUB sub-buckets per power of two gives
+    // ~3% value resolution across the full nanosecond range. Atomic so
+    // both acceptance paths record without taking the tree mutex.
+    _Atomic uint64_t lat_hist[LAT_HIST_BUCKETS];
+    _Atomic uint64_t lat_hist_count;
+    _Atomic uint64_t lat_hist_max_ns;
+
+    // Secondary index: height -> accepted block node, a dense array grown
+    // geometrically and written at acceptance time, so height-ordered
+    // replay is a linear scan instead of N hash probes. Guarded by `mutex`;
+    // slots are cleared when their block is pruned.
+    block_node_t** height_index;
+    size_t height_index_capacity;
+
+    // Decisions reached but not yet delivered to user code
+    decision_queue_t ready_decisions;
+    _Atomic bool delivering;     // one drainer at a time, for ordered delivery
+
+    // Binary event ring (see event_ring_emit); allocated at creation so
+    // emission is branch-plus-stores from day one
+    event_ring_t events;
+
+    // Byte accounting per allocation category (block-node bytes are derived
+    // from the slab pool instead). Updated at the allocation sites with
+    // relaxed atomics plus a CAS high-water mark.
+    mem_counter_t mem_payloads;
+    mem_counter_t mem_table_entries;
+    mem_counter_t mem_children;
+    mem_counter_t mem_vote_cache;
+    mem_counter_t mem_voter_state; // voter registry + per-block dedup bitmaps
+    mem_counter_t mem_indexes;     // conflict sets + height index
+
+    // Decided blocks whose parent has not been reported yet: held back here
+    // so decision delivery is always parent-before-child, which lets a
+    // replicated-log driver pipeline many in-flight entries and still apply
+    // commits in strict log order. Guarded by `mutex`; the list length is
+    // bounded by the pipeline depth.
+    block_node_t** deferred_decisions;
+    size_t deferred_count;
+    size_t deferred_capacity;
+
+    // Optional persistence: accepted blocks are appended here when the chain
+    // was created via lux_chain_open. NULL otherwise (and during replay).
+    block_log_t* block_log;
+
+    // Optional write-ahead vote journal (lux_consensus_attach_vote_journal).
+    // journal_replaying suppresses re-appending while startup replay runs
+    // through the batch-vote path.
+    vote_journal_t* vote_journal;
+    bool journal_replaying;
+
+    // Asynchronous vote pipeline (lux_chain_start/lux_chain_stop lifecycle)
+    vote_queue_t submit_queue;
+    pthread_t vote_worker;
+    _Atomic bool pipeline_running;
+    bool worker_started;
+    _Atomic bool group_claimed;  // a group worker is draining this chain
+    _Atomic bool in_group;       // registered with an engine group
 };
 
-// Fast hash function for block IDs
+// Fast hash function for block IDs. Returns the full hash; callers derive
+// the shard and bucket from it. Backed by the runtime-dispatched SIMD kernel
+// in blockid_simd.h (AVX2/SSE2 on x86, NEON on ARM, scalar elsewhere).
 static uint32_t hash_block_id(const uint8_t* block_id) {
-    uint32_t hash = 5381;
-    for (int i = 0; i < 32; i++) {
-        hash = ((hash << 5) + hash) + block_id[i];
-    }
-    return hash % HASH_TABLE_SIZE;
+    return blockid_hash(block_id);
 }
 
-// Find block in hash table
-static block_node_t* find_block(lux_chain_t* engine, const uint8_t* block_id) {
-    uint32_t index = hash_block_id(block_id);
-    hash_entry_t* entry = engine->block_table[index];
-    
-    while (entry) {
-        if (memcmp(entry->block_id, block_id, 32) == 0) {
-            return entry->node;
-        }
-        entry = entry->next;
-    }
-    return NULL;
+static inline uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
 
-// Add block to hash table
-static lux_error_t add_block_to_table(lux_chain_t* engine, block_node_t* node) {
-    uint32_t index = hash_block_id(node->block.id);
-    
-    hash_entry_t* new_entry = (hash_entry_t*)calloc(1, sizeof(hash_entry_t));
-    if (!new_entry) return LUX_ERROR_OUT_OF_MEMORY;
-    
-    memcpy(new_entry->block_id, node->block.id, 32);
-    new_entry->node = node;
-    new_entry->next = engine->block_table[index];
-    engine->block_table[index] = new_entry;
-    
-    return LUX_SUCCESS;
+// Timed mutex acquisition for the instrumentation counters. The fast path
+// is a trylock, so the two clock reads are only paid under contention.
+static inline void lock_timed(pthread_mutex_t* m, _Atomic uint64_t* wait_ns,
+                              _Atomic uint64_t* acquisitions) {
+    atomic_fetch_add_explicit(acquisitions, 1, memory_order_relaxed);
+    if (pthread_mutex_trylock(m) == 0) {
+        return;
+    }
+    uint64_t t0 = monotonic_ns();
+    pthread_mutex_lock(m);
+    atomic_fetch_add_explicit(wait_ns, monotonic_ns() - t0,
+                              memory_order_relaxed);
 }
 
-// Lux Consensus algorithm implementation
-static bool check_confidence(lux_chain_t* engine, block_node_t* node) {
-    return node->confidence_count >= engine->config.alpha;
+// xoshiro256** 1.0 — fast non-cryptographic PRNG for validator sampling.
+// Quality only needs to be good enough for unbiased sampling; libc rand()
+// is both slower and serialized on a global lock.
+static inline uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
 }
 
-static bool check_preference(lux_chain_t* engine, block_node_t* node) {
-    return node->preference_count >= engine->config.alpha;
+static uint64_t xoshiro_next(uint64_t s[4]) {
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return result;
 }
 
-static bool check_decision_threshold(lux_chain_t* engine, block_node_t* node) {
-    return node->confidence_count >= engine->config.beta;
+// Seed via splitmix64 so a zero seed still produces a full-period state
+static void xoshiro_seed(uint64_t s[4], uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        s[i] = z ^ (z >> 31);
+    }
 }
 
-// Process consensus decision
-static void process_decision(lux_chain_t* engine, block_node_t* node) {
-    if (node->is_accepted || node->is_rejected) {
-        return;
-    }
-    
-    if (check_decision_threshold(engine, node)) {
-        node->is_accepted = true;
-        engine->stats.blocks_accepted++;
-        
-        // Update preferred block
-        engine->preferred_block = node;
-        
-        // Notify via callback
-        if (engine->decision_callback) {
-            engine->decision_callback(node->block.id, engine->callback_user_data);
-        }
-        
-        // Reject conflicting blocks
-        for (size_t i = 0; i < node->parent->children_count; i++) {
-            block_node_t* sibling = node->parent->children[i];
-            if (sibling != node && !sibling->is_rejected) {
-                sibling->is_rejected = true;
-                engine->stats.blocks_rejected++;
-            }
+// Unbiased bounded draw (Lemire's multiply-shift with rejection)
+static uint32_t xoshiro_bounded(uint64_t s[4], uint32_t bound) {
+    uint64_t x = xoshiro_next(s) & 0xFFFFFFFFULL;
+    uint64_t m = x * bound;
+    uint32_t l = (uint32_t)m;
+    if (l < bound) {
+        uint32_t t = (uint32_t)(-(int32_t)bound) % bound;
+        while (l < t) {
+            x = xoshiro_next(s) & 0xFFFFFFFFULL;
+            m = x * bound;
+            l = (uint32_t)m;
         }
     }
+    return (uint32_t)(m >> 32);
 }
 
-// Library initialization
-lux_error_t lux_consensus_init(void) {
-    // Initialize any global state if needed
-    return LUX_SUCCESS;
+// Low bits select the shard, the remaining bits select the home slot.
+static table_shard_t* shard_for(lux_chain_t* engine, uint32_t hash) {
+    return &engine->block_table[hash & (TABLE_SHARD_COUNT - 1)];
 }
 
-lux_error_t lux_consensus_cleanup(void) {
-    // Cleanup global state
-    return LUX_SUCCESS;
+static size_t home_slot(uint32_t hash, size_t capacity) {
+    return (hash / TABLE_SHARD_COUNT) & (capacity - 1);
 }
 
-// Engine creation and destruction
-lux_error_t lux_consensus_engine_create(
-    lux_chain_t** engine_ptr,
-    const lux_config_t* config
-) {
-    if (!engine_ptr || !config) {
-        return LUX_ERROR_INVALID_PARAMS;
+// Find block within a shard. Caller must hold the shard lock. probes_out
+// (optional) receives the probe count for the instrumentation histogram.
+static block_node_t* find_in_shard(table_shard_t* shard, uint32_t hash,
+                                   const uint8_t* block_id,
+                                   uint32_t* probes_out) {
+    if (!shard->entries) {
+        if (probes_out) *probes_out = 0;
+        return NULL;
     }
-    
-    lux_chain_t* engine = (lux_chain_t*)calloc(1, sizeof(lux_chain_t));
-    if (!engine) {
-        return LUX_ERROR_OUT_OF_MEMORY;
+    size_t mask = shard->capacity - 1;
+    size_t idx = home_slot(hash, shard->capacity);
+    uint32_t psl = 0;
+
+    for (;;) {
+        table_entry_t* entry = &shard->entries[idx];
+        if (!entry->node) {
+            if (probes_out) *probes_out = psl;
+            return NULL; // hit an empty slot: key absent
+        }
+        // Robin-hood invariant: once resident entries are closer to home
+        // than our probe distance, the key cannot be further along.
+        if (entry->psl < psl) {
+            if (probes_out) *probes_out = psl;
+            return NULL;
+        }
+        if (entry->hash == hash && blockid_equal(entry->block_id, block_id)) {
+            if (probes_out) *probes_out = psl;
+            return entry->node;
+        }
+        idx = (idx + 1) & mask;
+        psl++;
     }
-    
-    // Copy configuration
-    memcpy(&engine->config, config, sizeof(lux_config_t));
-    
-    // Initialize synchronization
-    pthread_mutex_init(&engine->mutex, NULL);
-    pthread_rwlock_init(&engine->rwlock, NULL);
-    
-    // Initialize statistics
-    engine->start_time = (uint64_t)time(NULL);
-    
-    // Create genesis block
-    engine->genesis_block = (block_node_t*)calloc(1, sizeof(block_node_t));
-    if (!engine->genesis_block) {
-        free(engine);
+}
+
+// Robin-hood displacement insert into a raw entry array. The caller
+// guarantees there is at least one free slot.
+static void shard_insert_raw(table_entry_t* entries, size_t capacity,
+                             uint32_t hash, const uint8_t* block_id,
+                             block_node_t* node) {
+    table_entry_t incoming;
+    memcpy(incoming.block_id, block_id, 32);
+    incoming.node = node;
+    incoming.hash = hash;
+    incoming.psl = 0;
+
+    size_t mask = capacity - 1;
+    size_t idx = home_slot(hash, capacity);
+
+    for (;;) {
+        table_entry_t* slot = &entries[idx];
+        if (!slot->node) {
+            *slot = incoming;
+            return;
+        }
+        // Steal from the rich: swap when the resident entry is closer to
+        // its home than the incoming one, keeping probe lengths balanced.
+        if (slot->psl < incoming.psl) {
+            table_entry_t displaced = *slot;
+            *slot = incoming;
+            incoming = displaced;
+        }
+        idx = (idx + 1) & mask;
+        incoming.psl++;
+    }
+}
+
+// Grow a shard (or allocate it on first use). Caller must hold the shard
+// lock. Cached hashes make the rehash a single pass with no key re-hashing.
+static lux_error_t shard_grow(lux_chain_t* engine, table_shard_t* shard) {
+    size_t new_capacity = shard->entries ? shard->capacity * 2
+                                         : SHARD_INITIAL_CAPACITY;
+    table_entry_t* new_entries =
+        (table_entry_t*)calloc(new_capacity, sizeof(table_entry_t));
+    if (!new_entries) {
         return LUX_ERROR_OUT_OF_MEMORY;
     }
-    
-    // Genesis block is always accepted
-    engine->genesis_block->is_accepted = true;
-    engine->preferred_block = engine->genesis_block;
-    
-    *engine_ptr = engine;
+    mem_add(&engine->mem_table_entries,
+            new_capacity * sizeof(table_entry_t));
+
+    for (size_t i = 0; i < shard->capacity; i++) {
+        table_entry_t* entry = &shard->entries[i];
+        if (entry->node) {
+            shard_insert_raw(new_entries, new_capacity, entry->hash,
+                             entry->block_id, entry->node);
+        }
+    }
+
+    if (shard->entries) {
+        retired_entries_t* r =
+            (retired_entries_t*)malloc(sizeof(retired_entries_t));
+        if (r) {
+            r->entries = shard->entries;
+            r->next = shard->retired;
+            shard->retired = r;
+        } else {
+            // No retire node: leak the old array rather than free it under
+            // a lock-free reader. Bounded — it costs one superseded array
+            // per shard, only when the allocator is already failing — and
+            // the bytes stay counted since they are still held.
+        }
+    }
+    shard->entries = new_entries;
+    shard->capacity = new_capacity;
     return LUX_SUCCESS;
 }
 
-lux_error_t lux_consensus_engine_destroy(lux_chain_t* engine) {
-    if (!engine) {
+// Robin-hood backward-shift deletion. Caller must hold the shard lock.
+// Entries after the removed slot are shifted back one step until a slot is
+// empty or already home (psl 0), which restores the probe invariant without
+// tombstones, so lookups never slow down after heavy pruning.
+static bool shard_remove(table_shard_t* shard, uint32_t hash,
+                         const uint8_t* block_id) {
+    if (!shard->entries) {
+        return false;
+    }
+    size_t mask = shard->capacity - 1;
+    size_t idx = home_slot(hash, shard->capacity);
+    uint32_t psl = 0;
+
+    for (;;) {
+        table_entry_t* entry = &shard->entries[idx];
+        if (!entry->node || entry->psl < psl) {
+            return false; // absent
+        }
+        if (entry->hash == hash && blockid_equal(entry->block_id, block_id)) {
+            break;
+        }
+        idx = (idx + 1) & mask;
+        psl++;
+    }
+
+    atomic_fetch_add_explicit(&shard->version, 1, memory_order_release);
+
+    for (;;) {
+        size_t next = (idx + 1) & mask;
+        table_entry_t* next_entry = &shard->entries[next];
+        if (!next_entry->node || next_entry->psl == 0) {
+            shard->entries[idx].node = NULL;
+            break;
+        }
+        shard->entries[idx] = *next_entry;
+        shard->entries[idx].psl--;
+        idx = next;
+    }
+    shard->count--;
+    atomic_fetch_add_explicit(&shard->version, 1, memory_order_release);
+    return true;
+}
+
+// Find block in hash table, taking and releasing the shard lock. Nodes are
+// never freed while the chain is alive, so the returned pointer stays valid
+// after the lock is dropped.
+static block_node_t* find_block(lux_chain_t* engine, const uint8_t* block_id) {
+    uint32_t hash = hash_block_id(block_id);
+    table_shard_t* shard = shard_for(engine, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    uint32_t probes = 0;
+    block_node_t* node = find_in_shard(shard, hash, block_id, &probes);
+    pthread_mutex_unlock(&shard->lock);
+
+    size_t bucket = probes < LUX_PROBE_HIST_BUCKETS - 1
+        ? probes : LUX_PROBE_HIST_BUCKETS - 1;
+    atomic_fetch_add_explicit(&engine->probe_hist[bucket], 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&engine->table_lookups, 1,
+                              memory_order_relaxed);
+    return node;
+}
+
+// Lock-free lookup for the query path: probe under the shard seqlock. An
+// even version that is unchanged across the probe proves no insert, remove,
+// or growth raced with us, so the result is exactly what the locked probe
+// would have returned. On any instability fall back to find_block — hot
+// finality-wait loops stay lock-free, correctness never depends on winning
+// the race. The {entries, capacity} pair is validated against the version
+// before probing, so the probe never walks an array under the wrong mask;
+// within a validated snapshot, entries read mid-shift may still be torn,
+// but the array they live in stays mapped (retired arrays are parked, not
+// freed) and the closing re-check discards any result from that window.
+static block_node_t* find_block_lockfree(lux_chain_t* engine,
+                                         const uint8_t* block_id) {
+    uint32_t hash = hash_block_id(block_id);
+    table_shard_t* shard = shard_for(engine, hash);
+
+    for (int attempt = 0; attempt < 3; attempt++) {
+        uint64_t v1 = atomic_load_explicit(&shard->version,
+                                           memory_order_acquire);
+        if (v1 & 1) {
+            sched_yield(); // writer mid-mutation
+            continue;
+        }
+
+        table_entry_t* entries = shard->entries;
+        size_t capacity = shard->capacity;
+        // A grow between the two loads above could pair the old half-size
+        // array with the doubled capacity and index past its end; an
+        // unchanged version pins both fields to the same snapshot.
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&shard->version, memory_order_relaxed) != v1) {
+            continue;
+        }
+        block_node_t* node = NULL;
+        if (entries) {
+            size_t mask = capacity - 1;
+            size_t idx = home_slot(hash, capacity);
+            uint32_t psl = 0;
+            for (;;) {
+                table_entry_t* entry = &entries[idx];
+                if (!entry->node || entry->psl < psl) {
+                    break;
+                }
+                if (entry->hash == hash &&
+                    blockid_equal(entry->block_id, block_id)) {
+                    node = entry->node;
+                    break;
+                }
+                idx = (idx + 1) & mask;
+                psl++;
+            }
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&shard->version, memory_order_relaxed) == v1) {
+            return node;
+        }
+    }
+
+    return find_block(engine, block_id);
+}
+
+// Add block to hash table
+static lux_error_t add_block_to_table(lux_chain_t* engine, block_node_t* node) {
+    uint32_t hash = hash_block_id(node->block.id);
+    table_shard_t* shard = shard_for(engine, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    atomic_fetch_add_explicit(&shard->version, 1, memory_order_release);
+
+    // Grow above 75% load (or allocate the shard on first insert).
+    if (!shard->entries || (shard->count + 1) * 4 > shard->capacity * 3) {
+        lux_error_t err = shard_grow(engine, shard);
+        if (err != LUX_SUCCESS) {
+            // Growth failed but the insert can still proceed while slots
+            // remain; refuse only when the shard is actually full.
+            if (!shard->entries || shard->count >= shard->capacity) {
+                atomic_fetch_add_explicit(&shard->version, 1,
+                                          memory_order_release);
+                pthread_mutex_unlock(&shard->lock);
+                return err;
+            }
+        }
+    }
+
+    shard_insert_raw(shard->entries, shard->capacity, hash,
+                     node->block.id, node);
+    shard->count++;
+    atomic_fetch_add_explicit(&shard->version, 1, memory_order_release);
+
+    pthread_mutex_unlock(&shard->lock);
+    return LUX_SUCCESS;
+}
+
+// Presize every shard for `expected_blocks` total entries so inserts stay
+// under the 75% growth trigger until the hint is exceeded. Called once at
+// chain creation, before any concurrency; best-effort on OOM (the shard
+// just allocates lazily as before).
+static void table_presize(lux_chain_t* engine, uint32_t expected_blocks) {
+    size_t per_shard = (expected_blocks + TABLE_SHARD_COUNT - 1)
+        / TABLE_SHARD_COUNT;
+    size_t capacity = SHARD_INITIAL_CAPACITY;
+    while (capacity * 3 < per_shard * 4) { // hold per_shard below 75% load
+        capacity *= 2;
+    }
+    for (int i = 0; i < TABLE_SHARD_COUNT; i++) {
+        table_shard_t* shard = &engine->block_table[i];
+        shard->entries = (table_entry_t*)calloc(capacity,
+                                                sizeof(table_entry_t));
+        if (!shard->entries) {
+            return;
+        }
+        shard->capacity = capacity;
+        mem_add(&engine->mem_table_entries, capacity * sizeof(table_entry_t));
+    }
+}
+
+// Lux Consensus algorithm implementation
+// ---------------------------------------------------------------------------
+// Conflict-set index. Caller must hold engine->mutex for all of these.
+// ---------------------------------------------------------------------------
+
+static size_t conflict_bucket(const block_node_t* parent, uint64_t height) {
+    uint64_t h = blockid_mix64((uint64_t)(uintptr_t)parent ^ height);
+    return (size_t)(h & (CONFLICT_BUCKET_COUNT - 1));
+}
+
+static conflict_set_t* conflict_set_find(lux_chain_t* engine,
+                                         block_node_t* parent,
+                                         uint64_t height) {
+    conflict_set_t* set = engine->conflict_buckets[conflict_bucket(parent, height)];
+    while (set) {
+        if (set->parent == parent && set->height == height) {
+            return set;
+        }
+        set = set->next;
+    }
+    return NULL;
+}
+
+// Track an undecided node in its (parent, height) conflict set, creating the
+// set on first conflict. Best-effort: on allocation failure the node simply
+// stays out of the index and acceptance falls back to the sibling scan.
+static void conflict_set_add(lux_chain_t* engine, block_node_t* node) {
+    conflict_set_t* set = conflict_set_find(engine, node->parent,
+                                            node->block.height);
+    if (!set) {
+        set = (conflict_set_t*)calloc(1, sizeof(conflict_set_t));
+        if (!set) {
+            return;
+        }
+        mem_add(&engine->mem_indexes, sizeof(conflict_set_t));
+        set->parent = node->parent;
+        set->height = node->block.height;
+        size_t bucket = conflict_bucket(node->parent, node->block.height);
+        set->next = engine->conflict_buckets[bucket];
+        engine->conflict_buckets[bucket] = set;
+    }
+
+    if (set->count == set->capacity) {
+        size_t new_capacity = set->capacity ? set->capacity * 2 : 4;
+        block_node_t** grown = (block_node_t**)realloc(
+            set->members, new_capacity * sizeof(block_node_t*));
+        if (!grown) {
+            return;
+        }
+        mem_add(&engine->mem_indexes,
+                (new_capacity - set->capacity) * sizeof(block_node_t*));
+        set->members = grown;
+        set->capacity = new_capacity;
+    }
+
+    node->conflict_set = set;
+    node->conflict_idx = set->count;
+    set->members[set->count++] = node;
+}
+
+// Drop a decided node from its set: swap-remove keeps the member array
+// compact, and the moved node's idx is patched in O(1).
+static void conflict_set_remove(block_node_t* node) {
+    conflict_set_t* set = node->conflict_set;
+    if (!set) {
+        return;
+    }
+    size_t idx = node->conflict_idx;
+    block_node_t* last = set->members[--set->count];
+    set->members[idx] = last;
+    last->conflict_idx = idx;
+    node->conflict_set = NULL;
+}
+
+static void conflict_set_destroy_all(lux_chain_t* engine) {
+    for (size_t b = 0; b < CONFLICT_BUCKET_COUNT; b++) {
+        conflict_set_t* set = engine->conflict_buckets[b];
+        while (set) {
+            conflict_set_t* next = set->next;
+            free(set->members);
+            free(set);
+            set = next;
+        }
+        engine->conflict_buckets[b] = NULL;
+    }
+}
+
+static bool check_confidence(lux_chain_t* engine, block_node_t* node) {
+    return atomic_load(&node->confidence_count) >= engine->config.alpha;
+}
+
+// A node is the preferred member of its conflict set when it meets the
+// quorum and no undecided competitor in the set holds more preference
+// votes. The set's compact member array makes this a short sweep that
+// never touches the parent's full child list.
+static bool check_preference(lux_chain_t* engine, block_node_t* node) {
+    uint64_t own = atomic_load(&node->preference_count);
+    if (own < engine->config.alpha) {
+        return false;
+    }
+    conflict_set_t* set = node->conflict_set;
+    if (set) {
+        for (size_t i = 0; i < set->count; i++) {
+            block_node_t* rival = set->members[i];
+            if (rival != node && atomic_load(&rival->preference_count) > own) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool check_decision_threshold(lux_chain_t* engine, block_node_t* node) {
+    return atomic_load(&node->confidence_count) >= engine->config.beta;
+}
+
+static bool is_decided(block_node_t* node) {
+    return atomic_load(&node->is_accepted) || atomic_load(&node->is_rejected);
+}
+
+// Record an accepted block in the dense height index, growing it to the
+// next power of two above the height. Caller must hold engine->mutex.
+// Best-effort on OOM: replay falls back to ID lookups, consensus itself
+// is unaffected.
+static void height_index_set(lux_chain_t* engine, block_node_t* node) {
+    uint64_t h = node->block.height;
+    if (h >= engine->height_index_capacity) {
+        size_t cap = engine->height_index_capacity ? engine->height_index_capacity : 1024;
+        while (cap <= h) {
+            cap *= 2;
+        }
+        block_node_t** grown = (block_node_t**)realloc(
+            engine->height_index, cap * sizeof(block_node_t*));
+        if (!grown) {
+            return;
+        }
+        memset(grown + engine->height_index_capacity, 0,
+               (cap - engine->height_index_capacity) * sizeof(block_node_t*));
+        mem_add(&engine->mem_indexes,
+                (cap - engine->height_index_capacity) *
+                    sizeof(block_node_t*));
+        engine->height_index = grown;
+        engine->height_index_capacity = cap;
+    }
+    engine->height_index[h] = node;
+}
+
+// Publish a new preference. Caller must hold engine->mutex (writers are
+// serialized); readers use read_preference below.
+static void publish_preference(lux_chain_t* engine, block_node_t* node) {
+    engine->preferred_block = node;
+    atomic_fetch_add_explicit(&engine->pref_seq, 1, memory_order_release);
+    memcpy(engine->pref_id, node->block.id, 32);
+    atomic_fetch_add_explicit(&engine->pref_seq, 1, memory_order_release);
+}
+
+// Lock-free preference read: retry until the seqlock is stable. Writers
+// hold it only for a 32-byte copy, so the loop terminates quickly. A chain
+// that has decided nothing yet reports the all-zero genesis ID.
+static void read_preference(lux_chain_t* engine, uint8_t* block_id_out) {
+    for (;;) {
+        uint64_t v1 = atomic_load_explicit(&engine->pref_seq,
+                                           memory_order_acquire);
+        if (v1 & 1) {
+            continue;
+        }
+        memcpy(block_id_out, engine->pref_id, 32);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&engine->pref_seq,
+                                 memory_order_relaxed) == v1) {
+            return;
+        }
+    }
+}
+
+// Record one decision latency sample into the chain's log-linear
+// histogram. Two relaxed increments plus a CAS max; no locks, so both the
+// voted and the direct-add acceptance paths use it.
+static void record_decision_latency(lux_chain_t* engine, uint64_t ns) {
+    size_t idx;
+    if (ns < LAT_HIST_SUB) {
+        idx = (size_t)ns;
+    } else {
+        int msb = 63 - __builtin_clzll(ns);
+        idx = (size_t)(msb - LAT_HIST_SUB_BITS + 1) * LAT_HIST_SUB +
+              ((ns >> (msb - LAT_HIST_SUB_BITS)) & (LAT_HIST_SUB - 1));
+    }
+    if (idx >= LAT_HIST_BUCKETS) {
+        idx = LAT_HIST_BUCKETS - 1;
+    }
+    atomic_fetch_add_explicit(&engine->lat_hist[idx], 1,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&engine->lat_hist_count, 1,
+                              memory_order_relaxed);
+    uint64_t cur = atomic_load_explicit(&engine->lat_hist_max_ns,
+                                        memory_order_relaxed);
+    while (ns > cur &&
+           !atomic_compare_exchange_weak_explicit(
+               &engine->lat_hist_max_ns, &cur, ns,
+               memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// Fold a newly accepted block's height into the finalized frontier.
+// CAS max rather than a plain store: acceptance is not guaranteed to
+// arrive in height order.
+static void raise_finalized_height(lux_chain_t* engine, uint64_t height) {
+    uint64_t cur = atomic_load_explicit(&engine->finalized_height,
+                                        memory_order_relaxed);
+    while (height > cur &&
+           !atomic_compare_exchange_weak_explicit(
+               &engine->finalized_height, &cur, height,
+               memory_order_release, memory_order_relaxed)) {
+    }
+}
+
+// Release parked decisions whose parent has since been reported (or
+// rejected — rejected blocks count as reported, see process_decision).
+// Caller must hold engine->mutex. Restart the scan after each release: the
+// freed child may in turn unblock its own children, and the list stays
+// pipeline-depth short.
+static void release_deferred_decisions(lux_chain_t* engine) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t i = 0; i < engine->deferred_count; i++) {
+            block_node_t* held = engine->deferred_decisions[i];
+            block_node_t* p = held->parent;
+            if (!p || p == engine->genesis_block || p->decision_reported) {
+                engine->deferred_decisions[i] =
+                    engine->deferred_decisions[--engine->deferred_count];
+                held->decision_reported = true;
+                decision_queue_push(&engine->ready_decisions, held->block.id);
+                progress = true;
+                break;
+            }
+        }
+    }
+}
+
+// Queue an accepted block's decision, preserving parent-before-child order.
+// Caller must hold engine->mutex. A block whose parent is known but not yet
+// reported is parked on the deferred list; reporting a block releases any
+// parked children (transitively), so pipelined chains of in-flight entries
+// surface in log order no matter which one crossed the threshold first.
+// The decision_reported flag makes delivery exactly-once even if a block
+// decides through more than one path.
+static void enqueue_decision_ordered(lux_chain_t* engine, block_node_t* node) {
+    if (node->decision_reported) {
+        return;
+    }
+    block_node_t* parent = node->parent;
+    if (parent && parent != engine->genesis_block &&
+        !parent->decision_reported) {
+        if (engine->deferred_count == engine->deferred_capacity) {
+            size_t cap = engine->deferred_capacity ? engine->deferred_capacity * 2 : 8;
+            block_node_t** grown = (block_node_t**)realloc(
+                engine->deferred_decisions, cap * sizeof(block_node_t*));
+            if (!grown) {
+                // Last resort: deliver out of order rather than drop the
+                // decision entirely.
+                node->decision_reported = true;
+                decision_queue_push(&engine->ready_decisions, node->block.id);
+                return;
+            }
+            engine->deferred_decisions = grown;
+            engine->deferred_capacity = cap;
+        }
+        engine->deferred_decisions[engine->deferred_count++] = node;
+        return;
+    }
+
+    node->decision_reported = true;
+    decision_queue_push(&engine->ready_decisions, node->block.id);
+    release_deferred_decisions(engine);
+}
+
+// Process consensus decision. Caller must hold engine->mutex.
+static void journal_credit_decided(lux_chain_t* engine, block_node_t* node);
+
+static void process_decision(lux_chain_t* engine, block_node_t* node) {
+    if (is_decided(node)) {
+        return;
+    }
+
+    if (check_decision_threshold(engine, node)) {
+        atomic_store_explicit(&node->is_accepted, true, memory_order_release);
+        engine->stats.blocks_accepted++;
+
+        // Update preferred block
+        publish_preference(engine, node);
+        raise_finalized_height(engine, node->block.height);
+        height_index_set(engine, node);
+        event_ring_emit(&engine->events, LUX_EVENT_BLOCK_ACCEPTED,
+                        node->block.id, node->block.height);
+
+        // True decision latency: add call to acceptance, in nanoseconds
+        if (node->added_ns) {
+            uint64_t latency = monotonic_ns() - node->added_ns;
+            engine->decisions_measured++;
+            engine->decision_latency_total_ns += latency;
+            if (latency > engine->decision_latency_max_ns) {
+                engine->decision_latency_max_ns = latency;
+            }
+            record_decision_latency(engine, latency);
+        }
+
+        // Queue for delivery; user callbacks run outside the engine locks
+        // (see deliver_decisions), and children wait for their parent.
+        enqueue_decision_ordered(engine, node);
+
+        // The decided block's journaled votes are recovery-dead now
+        journal_credit_decided(engine, node);
+
+        // Persist if this chain is backed by a block log
+        if (engine->block_log) {
+            block_log_append(engine->block_log, node->block.id,
+                             node->block.parent_id, node->block.height,
+                             node->block.timestamp, node->block.data,
+                             node->block.data_size);
+        }
+
+        // Reject the rest of the conflict set: one sweep over the compact
+        // member array, touching only undecided competitors at this
+        // (parent, height). Nodes that never made it into the index (OOM at
+        // add time) fall back to the old sibling scan.
+        conflict_set_t* set = node->conflict_set;
+        size_t rejected = 0;
+        if (set) {
+            conflict_set_remove(node);
+            for (size_t i = 0; i < set->count; i++) {
+                block_node_t* rival = set->members[i];
+                atomic_store(&rival->is_rejected, true);
+                // Rejected blocks are never delivered; counting them as
+                // reported keeps accepted children from parking forever
+                // behind a parent that will never surface.
+                rival->decision_reported = true;
+                rival->conflict_set = NULL;
+                engine->stats.blocks_rejected++;
+                journal_credit_decided(engine, rival);
+                event_ring_emit(&engine->events, LUX_EVENT_BLOCK_REJECTED,
+                                rival->block.id, rival->block.height);
+                rejected++;
+            }
+            set->count = 0;
+        } else if (node->parent) {
+            for (size_t i = 0; i < node->parent->children_count; i++) {
+                block_node_t* sibling = node->parent->children[i];
+                if (sibling != node && !atomic_load(&sibling->is_rejected)) {
+                    atomic_store(&sibling->is_rejected, true);
+                    sibling->decision_reported = true;
+                    conflict_set_remove(sibling);
+                    engine->stats.blocks_rejected++;
+                    journal_credit_decided(engine, sibling);
+                    event_ring_emit(&engine->events, LUX_EVENT_BLOCK_REJECTED,
+                                    sibling->block.id, sibling->block.height);
+                    rejected++;
+                }
+            }
+        }
+        if (rejected > 0) {
+            release_deferred_decisions(engine);
+        }
+    }
+}
+
+// Release a node's payload according to its ownership mode.
+static void release_node_payload(lux_chain_t* engine, block_node_t* node) {
+    if (node->data_release) {
+        node->data_release(node->block.data, node->block.data_size,
+                           node->data_release_ctx);
+    } else if (node->data_copied) {
+        free(node->block.data);
+    }
+    if (node->block.data && (node->data_release || node->data_copied)) {
+        mem_sub(&engine->mem_payloads, node->block.data_size);
+    }
+    node->block.data = NULL;
+}
+
+// Library initialization
+lux_error_t lux_consensus_init(void) {
+    // Initialize any global state if needed
+    return LUX_SUCCESS;
+}
+
+lux_error_t lux_consensus_cleanup(void) {
+    // Cleanup global state
+    return LUX_SUCCESS;
+}
+
+// Engine creation and destruction
+lux_error_t lux_consensus_engine_create(
+    lux_chain_t** engine_ptr,
+    const lux_config_t* config
+) {
+    if (!engine_ptr || !config) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    
+    lux_chain_t* engine = (lux_chain_t*)calloc(1, sizeof(lux_chain_t));
+    if (!engine) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // Copy configuration
+    memcpy(&engine->config, config, sizeof(lux_config_t));
+    
+    // Initialize synchronization
+    pthread_mutex_init(&engine->mutex, NULL);
+    pthread_mutex_init(&engine->cache_mutex, NULL);
+    pthread_rwlock_init(&engine->rwlock, NULL);
+    for (int i = 0; i < TABLE_SHARD_COUNT; i++) {
+        pthread_mutex_init(&engine->block_table[i].lock, NULL);
+    }
+    slab_init(&engine->node_pool, sizeof(block_node_t));
+    engine->vote_ring_capacity = engine->config.vote_cache_capacity > 0
+        ? engine->config.vote_cache_capacity : VOTE_CACHE_DEFAULT_CAPACITY;
+    if (engine->config.expected_blocks > 0) {
+        table_presize(engine, engine->config.expected_blocks);
+        slab_reserve(&engine->node_pool, engine->config.expected_blocks);
+        // With a sized working set, reserve the analytics ring too so the
+        // first cached vote does not malloc under the cache mutex.
+        engine->vote_ring = (vote_cache_t*)malloc(
+            engine->vote_ring_capacity * sizeof(vote_cache_t));
+        if (engine->vote_ring) {
+            mem_add(&engine->mem_vote_cache,
+                    engine->vote_ring_capacity * sizeof(vote_cache_t));
+        }
+    }
+    if (decision_queue_init(&engine->ready_decisions) != LUX_SUCCESS) {
+        slab_destroy(&engine->node_pool);
+        free(engine);
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    event_ring_init(&engine->events); // best-effort: OOM just disables events
+    pthread_mutex_init(&engine->poll_mutex, NULL);
+    pthread_mutex_init(&engine->voter_mutex, NULL);
+    xoshiro_seed(engine->prng_state,
+                 (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)engine ^ monotonic_ns());
+
+    // Initialize statistics
+    engine->start_time = (uint64_t)time(NULL);
+
+    // Create genesis block
+    engine->genesis_block = (block_node_t*)slab_alloc(&engine->node_pool);
+    if (!engine->genesis_block) {
+        slab_destroy(&engine->node_pool);
+        free(engine);
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // Genesis block is always accepted (and never reported, so it cannot
+    // hold its children back)
+    engine->genesis_block->is_accepted = true;
+    engine->genesis_block->decision_reported = true;
+    engine->preferred_block = engine->genesis_block;
+    
+    *engine_ptr = engine;
+    return LUX_SUCCESS;
+}
+
+lux_error_t lux_consensus_engine_destroy(lux_chain_t* engine) {
+    if (!engine) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    // Stop the vote pipeline if the caller started one.
+    lux_chain_stop(engine);
+
+    pthread_mutex_lock(&engine->mutex);
+
+    // Free per-node heap allocations, then tear down the table and pools.
+    // The nodes and cached votes themselves are reclaimed in bulk by the
+    // slab teardown below — no per-object walk.
+    for (int s = 0; s < TABLE_SHARD_COUNT; s++) {
+        table_shard_t* shard = &engine->block_table[s];
+        for (size_t i = 0; i < shard->capacity; i++) {
+            block_node_t* node = shard->entries[i].node;
+            if (node) {
+                free(node->children);
+                free(atomic_load_explicit(&node->voter_bits,
+                                          memory_order_relaxed));
+                release_node_payload(engine, node);
+            }
+        }
+        free(shard->entries);
+        while (shard->retired) {
+            retired_entries_t* r = shard->retired;
+            shard->retired = r->next;
+            free(r->entries);
+            free(r);
+        }
+    }
+    free(engine->genesis_block->children);
+
+    slab_destroy(&engine->node_pool);
+    free(engine->vote_ring);
+
+    pthread_mutex_unlock(&engine->mutex);
+    if (engine->vote_journal) {
+        vote_journal_close(engine->vote_journal);
+        free(engine->vote_journal);
+        engine->vote_journal = NULL;
+    }
+    vote_queue_free(&engine->submit_queue);
+    decision_queue_free(&engine->ready_decisions);
+    event_ring_free(&engine->events);
+    free(engine->deferred_decisions);
+    free(engine->height_index);
+    conflict_set_destroy_all(engine);
+    free(engine->poll_scratch);
+    free(engine->poll_sampled);
+    free(atomic_load_explicit(&engine->voter_reg, memory_order_relaxed));
+    pthread_mutex_destroy(&engine->voter_mutex);
+    pthread_mutex_destroy(&engine->poll_mutex);
+    pthread_mutex_destroy(&engine->mutex);
+    pthread_mutex_destroy(&engine->cache_mutex);
+    pthread_rwlock_destroy(&engine->rwlock);
+    for (int i = 0; i < TABLE_SHARD_COUNT; i++) {
+        pthread_mutex_destroy(&engine->block_table[i].lock);
+    }
+
+    free(engine);
+    return LUX_SUCCESS;
+}
+
+// Append node to node->parent's children, growing the array with the
+// configured fan-out hint. Caller must hold engine->mutex; prune repairs
+// linkage exclusively through children arrays, so every node with a resident
+// parent must be registered here. On failure the node is left unlinked and
+// the caller decides how to degrade.
+static lux_error_t link_child(lux_chain_t* engine, block_node_t* node) {
+    block_node_t* parent = node->parent;
+    if (!parent) {
+        return LUX_SUCCESS;
+    }
+    if (parent->children_count >= parent->children_capacity) {
+        size_t new_capacity;
+        if (parent->children_capacity == 0) {
+            // First child: reserve the configured fan-out up front so hot
+            // parents never realloc under the mutex.
+            new_capacity = engine->config.expected_children_per_block > 4
+                ? engine->config.expected_children_per_block : 4;
+        } else {
+            // [C-009] Check for overflow before doubling capacity
+            if (parent->children_capacity > SIZE_MAX / 2) {
+                return LUX_ERROR_OUT_OF_MEMORY;
+            }
+            new_capacity = parent->children_capacity * 2;
+        }
+        // [C-009] Also check that the total allocation size won't overflow
+        if (new_capacity > SIZE_MAX / sizeof(block_node_t*)) {
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        block_node_t** new_children = (block_node_t**)realloc(
+            parent->children, new_capacity * sizeof(block_node_t*));
+        if (!new_children) {
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        mem_add(&engine->mem_children,
+                (new_capacity - parent->children_capacity) *
+                    sizeof(block_node_t*));
+        parent->children = new_children;
+        parent->children_capacity = new_capacity;
+        atomic_fetch_add_explicit(&engine->children_reallocs, 1,
+                                  memory_order_relaxed);
+    }
+    parent->children[parent->children_count++] = node;
+    return LUX_SUCCESS;
+}
+
+// Block operations
+lux_error_t lux_consensus_add_block(
+    lux_chain_t* engine,
+    const lux_block_t* block
+) {
+    if (!engine || !block) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    
+    // Duplicate check and verification run before the tree lock: an
+    // expensive verify callback (signature checks over block->data) must
+    // not serialize the engine, so concurrent adders verify their blocks
+    // in parallel and only verified blocks contend for admission.
+    if (find_block(engine, block->id)) {
+        return LUX_SUCCESS;
+    }
+    if (engine->verify_callback) {
+        if (!engine->verify_callback(block, engine->callback_user_data)) {
+            return LUX_ERROR_CONSENSUS_FAILED;
+        }
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+
+    // Re-check under the lock: another thread may have admitted the same
+    // block while we were verifying.
+    if (find_block(engine, block->id)) {
+        pthread_mutex_unlock(&engine->mutex);
+        return LUX_SUCCESS;
+    }
+
+    // Create new block node
+    block_node_t* node = (block_node_t*)slab_alloc(&engine->node_pool);
+    if (!node) {
+        pthread_mutex_unlock(&engine->mutex);
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    
+    // Copy block data
+    memcpy(&node->block, block, sizeof(lux_block_t));
+    node->added_ns = monotonic_ns();
+    if (block->data_size > 0 && block->data) {
+        node->block.data = malloc(block->data_size);
+        if (!node->block.data) {
+            slab_free(&engine->node_pool, node);
+            pthread_mutex_unlock(&engine->mutex);
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(node->block.data, block->data, block->data_size);
+        node->data_copied = true;
+        mem_add(&engine->mem_payloads, block->data_size);
+    }
+    
+    // Find parent
+    node->parent = find_block(engine, block->parent_id);
+    if (!node->parent) {
+        node->parent = engine->genesis_block;
+    }
+
+    // Add to parent's children
+    lux_error_t link_err = link_child(engine, node);
+    if (link_err != LUX_SUCCESS) {
+        free(node->block.data);
+        slab_free(&engine->node_pool, node);
+        pthread_mutex_unlock(&engine->mutex);
+        return link_err;
+    }
+    conflict_set_add(engine, node);
+    
+    // Add to hash table
+    lux_error_t err = add_block_to_table(engine, node);
+    if (err != LUX_SUCCESS) {
+        conflict_set_remove(node);
+        node->parent->children_count--; // node was the last child appended
+        free(node->block.data);
+        slab_free(&engine->node_pool, node);
+        pthread_mutex_unlock(&engine->mutex);
+        return err;
+    }
+
+    pthread_mutex_unlock(&engine->mutex);
+    return LUX_SUCCESS;
+}
+
+// Cache a vote for analytics. Caller must hold engine->cache_mutex.
+// [C-007] The ring's overwrite-oldest semantics bound the cache by
+// construction, so the old 10% eviction walk is gone entirely.
+static void cache_vote(lux_chain_t* engine, const lux_vote_t* vote) {
+    if (!engine->vote_ring) {
+        engine->vote_ring = (vote_cache_t*)malloc(
+            engine->vote_ring_capacity * sizeof(vote_cache_t));
+        if (!engine->vote_ring) {
+            return; // analytics cache is best-effort
+        }
+        mem_add(&engine->mem_vote_cache,
+                engine->vote_ring_capacity * sizeof(vote_cache_t));
+    }
+
+    vote_cache_t* slot = &engine->vote_ring[engine->vote_ring_head];
+    memcpy(slot->voter_id, vote->voter_id, 32);
+    memcpy(slot->block_id, vote->block_id, 32);
+    slot->timestamp = (uint64_t)time(NULL);
+
+    engine->vote_ring_head = (engine->vote_ring_head + 1) % engine->vote_ring_capacity;
+    if (engine->vote_ring_count < engine->vote_ring_capacity) {
+        engine->vote_ring_count++;
+    } else {
+        uint64_t total = atomic_fetch_add_explicit(
+            &engine->vote_cache_evictions, 1, memory_order_relaxed) + 1;
+        event_ring_emit(&engine->events, LUX_EVENT_VOTE_CACHE_EVICTED,
+                        NULL, total);
+    }
+}
+
+// Map a voter ID to its dense index, registering it on first sight. The
+// common case is a lock-free probe over published slots; only registration
+// of a brand-new voter takes voter_mutex. Returns UINT32_MAX when the
+// registry is exhausted (validator set over LUX_MAX_VALIDATORS), in which
+// case callers skip duplicate detection rather than drop the vote.
+static uint32_t voter_index(lux_chain_t* engine, const uint8_t* voter_id) {
+    uint32_t hash = hash_block_id(voter_id);
+    size_t mask = VOTER_REG_CAPACITY - 1;
+
+    voter_entry_t* reg = atomic_load_explicit(&engine->voter_reg,
+                                              memory_order_acquire);
+    if (reg) {
+        size_t idx = hash & mask;
+        for (size_t i = 0; i < VOTER_REG_CAPACITY; i++) {
+            uint32_t st = atomic_load_explicit(&reg[idx].state,
+                                               memory_order_acquire);
+            if (st == 0) {
+                break; // not registered yet
+            }
+            if (blockid_equal(reg[idx].voter_id, voter_id)) {
+                return reg[idx].index;
+            }
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    pthread_mutex_lock(&engine->voter_mutex);
+    reg = atomic_load_explicit(&engine->voter_reg, memory_order_relaxed);
+    if (!reg) {
+        reg = (voter_entry_t*)calloc(VOTER_REG_CAPACITY,
+                                     sizeof(voter_entry_t));
+        if (!reg) {
+            pthread_mutex_unlock(&engine->voter_mutex);
+            return UINT32_MAX;
+        }
+        mem_add(&engine->mem_voter_state,
+                VOTER_REG_CAPACITY * sizeof(voter_entry_t));
+        atomic_store_explicit(&engine->voter_reg, reg, memory_order_release);
+    }
+
+    // Re-probe under the lock: writers are serialized, so the first empty
+    // slot in probe order is ours.
+    size_t idx = hash & mask;
+    for (;;) {
+        uint32_t st = atomic_load_explicit(&reg[idx].state,
+                                           memory_order_relaxed);
+        if (st == 0) {
+            break;
+        }
+        if (blockid_equal(reg[idx].voter_id, voter_id)) {
+            uint32_t found = reg[idx].index;
+            pthread_mutex_unlock(&engine->voter_mutex);
+            return found;
+        }
+        idx = (idx + 1) & mask;
+    }
+
+    if (engine->voter_count >= LUX_MAX_VALIDATORS) {
+        pthread_mutex_unlock(&engine->voter_mutex);
+        return UINT32_MAX;
+    }
+
+    memcpy(reg[idx].voter_id, voter_id, 32);
+    reg[idx].index = engine->voter_count++;
+    atomic_store_explicit(&reg[idx].state, 1, memory_order_release);
+    uint32_t assigned = reg[idx].index;
+    pthread_mutex_unlock(&engine->voter_mutex);
+    return assigned;
+}
+
+// Apply one vote's counts to a node unless this validator already voted
+// this way on this block. Returns false for suppressed duplicates, which
+// cost one registry probe and one bit test — no counter bump, no cache
+// insert, no mutex. Counters are atomic, so no lock is required;
+// concurrent voters on the same block just contend on the cache line.
+static bool apply_vote_counts(lux_chain_t* engine, block_node_t* node,
+                              const lux_vote_t* vote) {
+    uint32_t idx = voter_index(engine, vote->voter_id);
+    if (idx != UINT32_MAX) {
+        uint64_t* words = atomic_load_explicit(&node->voter_bits,
+                                               memory_order_acquire);
+        if (!words) {
+            uint64_t* fresh = (uint64_t*)calloc(2 * VOTER_WORDS,
+                                                sizeof(uint64_t));
+            if (fresh) {
+                uint64_t* expected = NULL;
+                if (atomic_compare_exchange_strong(&node->voter_bits,
+                                                   &expected, fresh)) {
+                    words = fresh;
+                    mem_add(&engine->mem_voter_state,
+                            2 * VOTER_WORDS * sizeof(uint64_t));
+                } else {
+                    free(fresh); // another voter won the race
+                    words = expected;
+                }
+            }
+        }
+        if (words) {
+            size_t base = vote->is_preference ? 0 : VOTER_WORDS;
+            _Atomic uint64_t* word =
+                (_Atomic uint64_t*)&words[base + idx / 64];
+            uint64_t bit = 1ULL << (idx % 64);
+            uint64_t old = atomic_fetch_or_explicit(word, bit,
+                                                    memory_order_relaxed);
+            if (old & bit) {
+                return false; // replayed vote
+            }
+        }
+    }
+
+    if (vote->is_preference) {
+        atomic_fetch_add_explicit(&node->preference_count, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&node->confidence_count, 1, memory_order_relaxed);
+    }
+    return true;
+}
+
+// Journal an applied vote for crash recovery. Replay accounts without
+// re-appending (the record is already on disk); votes for decided blocks are
+// skipped entirely since their counts no longer matter. A vote that races
+// the decision may leak into outstanding, which only defers truncation.
+static void journal_applied_vote(lux_chain_t* engine, block_node_t* node,
+                                 const lux_vote_t* vote) {
+    if (!engine->vote_journal || is_decided(node)) {
+        return;
+    }
+    if (!engine->journal_replaying) {
+        vote_journal_append(engine->vote_journal, vote);
+    }
+    atomic_fetch_add_explicit(&node->journaled_votes, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&engine->vote_journal->outstanding, 1,
+                              memory_order_relaxed);
+}
+
+// Credit a decided node's journaled votes back to the journal; once nothing
+// outstanding remains, every record references a decided block and the file
+// is truncated wholesale.
+static void journal_credit_decided(lux_chain_t* engine, block_node_t* node) {
+    if (!engine->vote_journal) {
+        return;
+    }
+    uint32_t jv = atomic_exchange_explicit(&node->journaled_votes, 0,
+                                           memory_order_relaxed);
+    if (jv == 0) {
+        return;
+    }
+    uint64_t left = atomic_fetch_sub_explicit(
+        &engine->vote_journal->outstanding, jv, memory_order_relaxed);
+    if (left == jv) {
+        vote_journal_truncate(engine->vote_journal);
+    }
+}
+
+// Run the decision check for a node, taking the tree mutex only when the
+// threshold has actually been crossed. The threshold is re-checked inside
+// process_decision under the lock, so racing voters decide a node once.
+static void maybe_decide(lux_chain_t* engine, block_node_t* node) {
+    if (is_decided(node) || !check_decision_threshold(engine, node)) {
+        return;
+    }
+    lock_timed(&engine->mutex, &engine->tree_lock_wait_ns,
+               &engine->tree_lock_acquisitions);
+    process_decision(engine, node);
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+// Deliver ready decisions to the registered callback. Must be called with
+// no engine locks held: the callback may re-enter the API freely, and slow
+// callbacks no longer stall concurrent vote processing. Exactly one thread
+// drains at a time — two threads popping the ring could invoke the callback
+// child-before-parent, undoing the ordered enqueue — and the claim is
+// re-taken while entries remain, so a decision pushed during the handoff
+// window is picked up rather than stranded.
+static void deliver_decisions(lux_chain_t* engine) {
+    if (!engine->decision_callback) {
+        return; // left queued for lux_consensus_drain_decisions
+    }
+    uint8_t block_id[32];
+    while (decision_queue_nonempty(&engine->ready_decisions)) {
+        if (atomic_exchange_explicit(&engine->delivering, true,
+                                     memory_order_acquire)) {
+            return; // the current drainer will observe our entries
+        }
+        while (decision_queue_pop(&engine->ready_decisions, block_id)) {
+            engine->decision_callback(block_id, engine->callback_user_data);
+        }
+        atomic_store_explicit(&engine->delivering, false, memory_order_release);
+    }
+}
+
+// Vote processing
+lux_error_t lux_consensus_process_vote(
+    lux_chain_t* engine,
+    const lux_vote_t* vote
+) {
+    if (!engine || !vote) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    block_node_t* node = find_block(engine, vote->block_id);
+    if (!node) {
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    // Update vote counts; replayed votes early-out before any mutex work
+    if (!apply_vote_counts(engine, node, vote)) {
+        return LUX_SUCCESS;
+    }
+    journal_applied_vote(engine, node, vote);
+
+    // Cache vote for analytics
+    lock_timed(&engine->cache_mutex, &engine->cache_lock_wait_ns,
+               &engine->cache_lock_acquisitions);
+    cache_vote(engine, vote);
+    engine->stats.votes_processed++;
+    pthread_mutex_unlock(&engine->cache_mutex);
+
+    if (engine->vote_journal && !engine->journal_replaying) {
+        vote_journal_commit(engine->vote_journal);
+    }
+
+    // Check for consensus decision
+    maybe_decide(engine, node);
+    deliver_decisions(engine);
+
+    return LUX_SUCCESS;
+}
+
+// Batch vote processing: one lock acquisition for the whole batch, one hash
+// probe per distinct block (consecutive votes for the same block reuse the
+// previous lookup), and one decision check per affected node at the end.
+lux_error_t lux_consensus_process_votes(
+    lux_chain_t* engine,
+    const lux_vote_t* votes,
+    size_t num_votes,
+    lux_error_t* results
+) {
+    if (!engine || (!votes && num_votes > 0)) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    if (num_votes == 0) {
+        return LUX_SUCCESS;
+    }
+
+    // Collect the distinct nodes touched by this batch so process_decision
+    // runs once per node instead of once per vote. Small batches stay on the
+    // stack; larger ones spill to a heap array.
+    enum { AFFECTED_INLINE = 64 };
+    block_node_t* affected_inline[AFFECTED_INLINE];
+    block_node_t** affected = affected_inline;
+    size_t affected_count = 0;
+    size_t affected_capacity = AFFECTED_INLINE;
+
+    block_node_t* last_node = NULL;
+    const uint8_t* last_block_id = NULL;
+    size_t applied = 0;
+
+    lock_timed(&engine->cache_mutex, &engine->cache_lock_wait_ns,
+               &engine->cache_lock_acquisitions);
+
+    for (size_t i = 0; i < num_votes; i++) {
+        const lux_vote_t* vote = &votes[i];
+
+        // Votes in a batch are typically grouped by block; avoid re-probing
+        // the table when the block id matches the previous vote.
+        block_node_t* node;
+        if (last_block_id && blockid_equal(last_block_id, vote->block_id)) {
+            node = last_node;
+        } else {
+            node = find_block(engine, vote->block_id);
+            last_node = node;
+            last_block_id = vote->block_id;
+        }
+
+        if (!node) {
+            if (results) results[i] = LUX_ERROR_INVALID_STATE;
+            continue;
+        }
+
+        if (!apply_vote_counts(engine, node, vote)) {
+            // Replayed vote: suppressed, nothing to count or cache
+            if (results) results[i] = LUX_SUCCESS;
+            continue;
+        }
+        cache_vote(engine, vote);
+        journal_applied_vote(engine, node, vote);
+        applied++;
+        if (results) results[i] = LUX_SUCCESS;
+
+        // Track the node for the post-batch decision sweep. is_processing
+        // doubles as the "already claimed for a sweep" marker; the atomic
+        // exchange keeps concurrent batches from double-listing a node.
+        if (!atomic_exchange(&node->is_processing, true)) {
+            if (affected_count == affected_capacity) {
+                size_t new_capacity = affected_capacity * 2;
+                block_node_t** grown;
+                if (affected == affected_inline) {
+                    grown = (block_node_t**)malloc(new_capacity * sizeof(block_node_t*));
+                    if (grown) {
+                        memcpy(grown, affected_inline, affected_count * sizeof(block_node_t*));
+                    }
+                } else {
+                    grown = (block_node_t**)realloc(affected, new_capacity * sizeof(block_node_t*));
+                }
+                if (!grown) {
+                    // Out of memory for the dedup list: fall back to checking
+                    // this node immediately rather than dropping the vote.
+                    atomic_store(&node->is_processing, false);
+                    maybe_decide(engine, node);
+                    continue;
+                }
+                affected = grown;
+                affected_capacity = new_capacity;
+            }
+            affected[affected_count++] = node;
+        }
+    }
+
+    engine->stats.votes_processed += applied;
+    pthread_mutex_unlock(&engine->cache_mutex);
+
+    // Group commit: one fdatasync for the whole batch
+    if (applied > 0 && engine->vote_journal && !engine->journal_replaying) {
+        vote_journal_commit(engine->vote_journal);
+    }
+
+    // One decision check per affected node.
+    for (size_t i = 0; i < affected_count; i++) {
+        atomic_store(&affected[i]->is_processing, false);
+        maybe_decide(engine, affected[i]);
+    }
+    deliver_decisions(engine);
+
+    if (affected != affected_inline) {
+        free(affected);
+    }
+    return LUX_SUCCESS;
+}
+
+// Unaligned little-endian reads for the vote-frame parser: network buffers
+// carry no alignment guarantee.
+static uint16_t frame_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t frame_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+lux_error_t lux_consensus_ingest_vote_frame(
+    lux_chain_t* engine,
+    const uint8_t* frame,
+    size_t len
+) {
+    if (!engine || !frame) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    // Structural validation pass: every length, index, and the group sort
+    // order is checked before a single vote is applied, so a malformed
+    // frame can never leave the engine half-updated.
+    if (len < 8 || frame_u32(frame) != LUX_VOTE_FRAME_MAGIC) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    uint32_t num_voters = frame_u16(frame + 4);
+    uint32_t num_groups = frame_u16(frame + 6);
+    if (num_voters == 0) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    size_t off = 8 + (size_t)num_voters * 32;
+    if (off > len) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    const uint8_t* voters = frame + 8;
+
+    const uint8_t* prev_block_id = NULL;
+    size_t group_off = off;
+    for (uint32_t g = 0; g < num_groups; g++) {
+        if (group_off + 34 > len) {
+            return LUX_ERROR_INVALID_PARAMS;
+        }
+        const uint8_t* block_id = frame + group_off;
+        if (prev_block_id && memcmp(prev_block_id, block_id, 32) >= 0) {
+            return LUX_ERROR_INVALID_PARAMS; // groups must be sorted, unique
+        }
+        prev_block_id = block_id;
+        uint32_t group_votes = frame_u16(frame + group_off + 32);
+        group_off += 34;
+        if (group_off + (size_t)group_votes * 2 > len) {
+            return LUX_ERROR_INVALID_PARAMS;
+        }
+        for (uint32_t v = 0; v < group_votes; v++) {
+            if ((frame_u16(frame + group_off + v * 2) & 0x7FFF) >= num_voters) {
+                return LUX_ERROR_INVALID_PARAMS;
+            }
+        }
+        group_off += (size_t)group_votes * 2;
+    }
+    if (group_off != len) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    // Apply pass: mirrors lux_consensus_process_votes, but the grouping is
+    // given by the wire format — one table probe and one decision check per
+    // block, votes applied straight out of the buffer.
+    size_t applied = 0;
+
+    lock_timed(&engine->cache_mutex, &engine->cache_lock_wait_ns,
+               &engine->cache_lock_acquisitions);
+
+    group_off = off;
+    for (uint32_t g = 0; g < num_groups; g++) {
+        const uint8_t* block_id = frame + group_off;
+        uint32_t group_votes = frame_u16(frame + group_off + 32);
+        group_off += 34;
+
+        block_node_t* node = find_block(engine, block_id);
+        if (!node) {
+            group_off += (size_t)group_votes * 2; // unknown block: skip group
+            continue;
+        }
+
+        lux_vote_t vote;
+        memcpy(vote.block_id, block_id, 32);
+        for (uint32_t v = 0; v < group_votes; v++) {
+            uint16_t entry = frame_u16(frame + group_off + v * 2);
+            memcpy(vote.voter_id, voters + (size_t)(entry & 0x7FFF) * 32, 32);
+            vote.is_preference = (entry & 0x8000) != 0;
+
+            if (!apply_vote_counts(engine, node, &vote)) {
+                continue; // replayed vote
+            }
+            cache_vote(engine, &vote);
+            applied++;
+        }
+        group_off += (size_t)group_votes * 2;
+
+        // One decision check per group. The group's node can be checked
+        // right away: the frame never revisits a block, so there is no
+        // cross-group dedup list to maintain.
+        atomic_store(&node->is_processing, true);
+    }
+
+    engine->stats.votes_processed += applied;
+    pthread_mutex_unlock(&engine->cache_mutex);
+
+    group_off = off;
+    for (uint32_t g = 0; g < num_groups; g++) {
+        const uint8_t* block_id = frame + group_off;
+        uint32_t group_votes = frame_u16(frame + group_off + 32);
+        group_off += 34 + (size_t)group_votes * 2;
+
+        block_node_t* node = find_block_lockfree(engine, block_id);
+        if (node && atomic_exchange(&node->is_processing, false)) {
+            maybe_decide(engine, node);
+        }
+    }
+    deliver_decisions(engine);
+
+    return LUX_SUCCESS;
+}
+
+// Application-pumped delivery: hand out up to max_decisions finalized block
+// IDs (32 bytes each) from the ready queue.
+lux_error_t lux_consensus_drain_decisions(
+    lux_chain_t* engine,
+    size_t max_decisions,
+    uint8_t* block_ids_out,
+    size_t* num_out
+) {
+    if (!engine || !block_ids_out || !num_out) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    size_t n = 0;
+    while (n < max_decisions &&
+           decision_queue_pop(&engine->ready_decisions, block_ids_out + n * 32)) {
+        n++;
+    }
+    *num_out = n;
+    return LUX_SUCCESS;
+}
+
+// Asynchronous submission: push onto the lock-free ingest queue and return.
+// The engine-owned worker thread (see vote_worker_main) drains the queue in
+// batches through the same path as lux_consensus_process_votes.
+lux_error_t lux_consensus_submit_vote(
+    lux_chain_t* engine,
+    const lux_vote_t* vote
+) {
+    if (!engine || !vote) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    if (!atomic_load_explicit(&engine->pipeline_running, memory_order_acquire)) {
+        return LUX_ERROR_INVALID_STATE;
+    }
+    if (!vote_queue_push(&engine->submit_queue, vote)) {
+        return LUX_ERROR_QUEUE_FULL;
+    }
+    return LUX_SUCCESS;
+}
+
+// Query operations
+lux_error_t lux_consensus_is_accepted(
+    lux_chain_t* engine,
+    const uint8_t* block_id,
+    bool* is_accepted
+) {
+    if (!engine || !block_id || !is_accepted) {
         return LUX_ERROR_INVALID_PARAMS;
     }
     
-    pthread_mutex_lock(&engine->mutex);
-    
-    // Clean up hash table
-    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
-        hash_entry_t* entry = engine->block_table[i];
-        while (entry) {
-            hash_entry_t* next = entry->next;
-            free(entry);
-            entry = next;
-        }
-    }
-    
-    // Clean up vote cache
-    vote_cache_t* vote = engine->vote_cache;
-    while (vote) {
-        vote_cache_t* next = vote->next;
-        free(vote);
-        vote = next;
+    block_node_t* node = find_block_lockfree(engine, block_id);
+    if (!node) {
+        return LUX_ERROR_INVALID_STATE;
     }
-    
-    pthread_mutex_unlock(&engine->mutex);
-    pthread_mutex_destroy(&engine->mutex);
-    pthread_rwlock_destroy(&engine->rwlock);
-    
-    free(engine);
+
+    *is_accepted = atomic_load_explicit(&node->is_accepted,
+                                        memory_order_acquire);
     return LUX_SUCCESS;
 }
 
-// Block operations
-lux_error_t lux_consensus_add_block(
+// Bulk acceptance check. IDs are counting-sorted by shard first, so each
+// shard lock is taken at most once and its entry array is walked while hot;
+// a 5,000-ID catch-up batch costs 64 lock pairs instead of 5,000.
+lux_error_t lux_consensus_is_accepted_batch(
     lux_chain_t* engine,
-    const lux_block_t* block
+    const uint8_t* ids,
+    size_t num_ids,
+    uint8_t* out_flags
 ) {
-    if (!engine || !block) {
+    if (!engine || !ids || !out_flags) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    pthread_mutex_lock(&engine->mutex);
-    
-    // Check if block already exists
-    if (find_block(engine, block->id)) {
-        pthread_mutex_unlock(&engine->mutex);
+    if (num_ids == 0) {
         return LUX_SUCCESS;
     }
-    
-    // Verify block if callback is set
-    if (engine->verify_callback) {
-        if (!engine->verify_callback(block, engine->callback_user_data)) {
-            pthread_mutex_unlock(&engine->mutex);
-            return LUX_ERROR_CONSENSUS_FAILED;
-        }
-    }
-    
-    // Create new block node
-    block_node_t* node = (block_node_t*)calloc(1, sizeof(block_node_t));
-    if (!node) {
-        pthread_mutex_unlock(&engine->mutex);
+
+    uint32_t* hashes = (uint32_t*)malloc(num_ids * sizeof(uint32_t));
+    size_t* order = (size_t*)malloc(num_ids * sizeof(size_t));
+    if (!hashes || !order) {
+        free(hashes);
+        free(order);
         return LUX_ERROR_OUT_OF_MEMORY;
     }
-    
-    // Copy block data
-    memcpy(&node->block, block, sizeof(lux_block_t));
-    if (block->data_size > 0 && block->data) {
-        node->block.data = malloc(block->data_size);
-        if (!node->block.data) {
-            free(node);
-            pthread_mutex_unlock(&engine->mutex);
-            return LUX_ERROR_OUT_OF_MEMORY;
-        }
-        memcpy(node->block.data, block->data, block->data_size);
+
+    // Counting sort by shard: one histogram pass, one scatter pass.
+    size_t shard_start[TABLE_SHARD_COUNT + 1] = {0};
+    for (size_t i = 0; i < num_ids; i++) {
+        hashes[i] = hash_block_id(ids + i * 32);
+        shard_start[(hashes[i] & (TABLE_SHARD_COUNT - 1)) + 1]++;
     }
-    
-    // Find parent
-    node->parent = find_block(engine, block->parent_id);
-    if (!node->parent) {
-        node->parent = engine->genesis_block;
+    for (int sh = 0; sh < TABLE_SHARD_COUNT; sh++) {
+        shard_start[sh + 1] += shard_start[sh];
     }
-    
-    // Add to parent's children
-    if (node->parent->children_count >= node->parent->children_capacity) {
-        size_t new_capacity;
-        if (node->parent->children_capacity == 0) {
-            new_capacity = 4;
-        } else {
-            // [C-009] Check for overflow before doubling capacity
-            if (node->parent->children_capacity > SIZE_MAX / 2) {
-                free(node->block.data);
-                free(node);
-                pthread_mutex_unlock(&engine->mutex);
-                return LUX_ERROR_OUT_OF_MEMORY;
-            }
-            new_capacity = node->parent->children_capacity * 2;
-        }
-        // [C-009] Also check that the total allocation size won't overflow
-        if (new_capacity > SIZE_MAX / sizeof(block_node_t*)) {
-            free(node->block.data);
-            free(node);
-            pthread_mutex_unlock(&engine->mutex);
-            return LUX_ERROR_OUT_OF_MEMORY;
+    size_t fill[TABLE_SHARD_COUNT];
+    memcpy(fill, shard_start, sizeof(fill));
+    for (size_t i = 0; i < num_ids; i++) {
+        order[fill[hashes[i] & (TABLE_SHARD_COUNT - 1)]++] = i;
+    }
+
+    for (int sh = 0; sh < TABLE_SHARD_COUNT; sh++) {
+        size_t begin = shard_start[sh];
+        size_t end = shard_start[sh + 1];
+        if (begin == end) {
+            continue;
         }
-        block_node_t** new_children = (block_node_t**)realloc(
-            node->parent->children,
-            new_capacity * sizeof(block_node_t*)
-        );
-        if (!new_children) {
-            free(node->block.data);
-            free(node);
-            pthread_mutex_unlock(&engine->mutex);
-            return LUX_ERROR_OUT_OF_MEMORY;
+        table_shard_t* shard = &engine->block_table[sh];
+        pthread_mutex_lock(&shard->lock);
+        for (size_t j = begin; j < end; j++) {
+            size_t i = order[j];
+            block_node_t* node =
+                find_in_shard(shard, hashes[i], ids + i * 32, NULL);
+            out_flags[i] = node && atomic_load_explicit(&node->is_accepted,
+                                                        memory_order_acquire)
+                ? 1 : 0;
         }
-        node->parent->children = new_children;
-        node->parent->children_capacity = new_capacity;
-    }
-    node->parent->children[node->parent->children_count++] = node;
-    
-    // Add to hash table
-    lux_error_t err = add_block_to_table(engine, node);
-    if (err != LUX_SUCCESS) {
-        free(node->block.data);
-        free(node);
-        pthread_mutex_unlock(&engine->mutex);
-        return err;
+        pthread_mutex_unlock(&shard->lock);
     }
-    
-    pthread_mutex_unlock(&engine->mutex);
+
+    free(hashes);
+    free(order);
     return LUX_SUCCESS;
 }
 
-// Vote processing
-lux_error_t lux_consensus_process_vote(
+lux_error_t lux_consensus_get_finalized_height(
     lux_chain_t* engine,
-    const lux_vote_t* vote
+    uint64_t* height
 ) {
-    if (!engine || !vote) {
+    if (!engine || !height) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    pthread_mutex_lock(&engine->mutex);
-    
-    block_node_t* node = find_block(engine, vote->block_id);
-    if (!node) {
-        pthread_mutex_unlock(&engine->mutex);
-        return LUX_ERROR_INVALID_STATE;
-    }
-    
-    // Update vote counts
-    if (vote->is_preference) {
-        node->preference_count++;
-    } else {
-        node->confidence_count++;
+    *height = atomic_load_explicit(&engine->finalized_height,
+                                   memory_order_acquire);
+    return LUX_SUCCESS;
+}
+
+lux_error_t lux_chain_get_block_by_height(
+    lux_chain_t* chain,
+    uint64_t height,
+    lux_block_t* out
+) {
+    if (!chain || !out) {
+        return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    // Cache vote for analytics
-    vote_cache_t* cached_vote = (vote_cache_t*)malloc(sizeof(vote_cache_t));
-    if (cached_vote) {
-        memcpy(cached_vote->voter_id, vote->voter_id, 32);
-        memcpy(cached_vote->block_id, vote->block_id, 32);
-        cached_vote->timestamp = (uint64_t)time(NULL);
-        cached_vote->next = engine->vote_cache;
-        engine->vote_cache = cached_vote;
-        engine->vote_cache_size++;
-        
-        // [C-007] Evict 10% of cache when over limit to prevent DoS via unbounded growth.
-        // Previous code evicted only 1 entry (O(n) traversal per vote, negligible eviction).
-        if (engine->vote_cache_size > 10000) {
-            size_t evict_count = engine->vote_cache_size / 10; // 10%
-            if (evict_count == 0) evict_count = 1;
-
-            // Walk to the node just before the eviction tail
-            vote_cache_t* cursor = engine->vote_cache;
-            size_t keep_count = engine->vote_cache_size - evict_count;
-            for (size_t i = 1; i < keep_count && cursor->next; i++) {
-                cursor = cursor->next;
-            }
 
-            // Free the tail (oldest entries)
-            vote_cache_t* tail = cursor->next;
-            cursor->next = NULL;
-            while (tail) {
-                vote_cache_t* next = tail->next;
-                free(tail);
-                tail = next;
-            }
-            engine->vote_cache_size = keep_count;
-        }
+    pthread_mutex_lock(&chain->mutex);
+    block_node_t* node = height < chain->height_index_capacity
+        ? chain->height_index[height] : NULL;
+    if (!node || !atomic_load_explicit(&node->is_accepted,
+                                       memory_order_acquire)) {
+        pthread_mutex_unlock(&chain->mutex);
+        return LUX_ERROR_INVALID_STATE;
     }
-    
-    engine->stats.votes_processed++;
-    
-    // Check for consensus decision
-    process_decision(engine, node);
-    
-    pthread_mutex_unlock(&engine->mutex);
+    memcpy(out, &node->block, sizeof(lux_block_t));
+    pthread_mutex_unlock(&chain->mutex);
     return LUX_SUCCESS;
 }
 
-// Query operations
-lux_error_t lux_consensus_is_accepted(
-    lux_chain_t* engine,
-    const uint8_t* block_id,
-    bool* is_accepted
+lux_error_t lux_chain_iterate_accepted(
+    lux_chain_t* chain,
+    uint64_t from_height,
+    uint64_t to_height,
+    lux_callback_block_visit visit,
+    void* user_data,
+    uint64_t* num_visited
 ) {
-    if (!engine || !block_id || !is_accepted) {
+    if (!chain || !visit || from_height > to_height) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    pthread_rwlock_rdlock(&engine->rwlock);
-    
-    block_node_t* node = find_block(engine, block_id);
-    if (!node) {
-        pthread_rwlock_unlock(&engine->rwlock);
-        return LUX_ERROR_INVALID_STATE;
+
+    // Scan the dense index in chunks: copy a run of blocks out under the
+    // mutex, then invoke the callback with the lock dropped, so user code
+    // never runs inside the engine and may re-enter the API.
+    enum { ITERATE_CHUNK = 64 };
+    lux_block_t chunk[ITERATE_CHUNK];
+    uint64_t visited = 0;
+    uint64_t h = from_height;
+    bool stopped = false;
+
+    while (!stopped && h <= to_height) {
+        size_t n = 0;
+        pthread_mutex_lock(&chain->mutex);
+        for (; h <= to_height && n < ITERATE_CHUNK; h++) {
+            if (h >= chain->height_index_capacity) {
+                h = to_height + 1; // nothing resident beyond the index
+                break;
+            }
+            block_node_t* node = chain->height_index[h];
+            if (node && atomic_load_explicit(&node->is_accepted,
+                                             memory_order_acquire)) {
+                memcpy(&chunk[n++], &node->block, sizeof(lux_block_t));
+            }
+        }
+        pthread_mutex_unlock(&chain->mutex);
+
+        for (size_t i = 0; i < n; i++) {
+            visited++;
+            if (!visit(&chunk[i], user_data)) {
+                stopped = true;
+                break;
+            }
+        }
+        if (n == 0 && h <= to_height) {
+            break; // defensive: no progress possible
+        }
+    }
+
+    if (num_visited) {
+        *num_visited = visited;
     }
-    
-    *is_accepted = node->is_accepted;
-    
-    pthread_rwlock_unlock(&engine->rwlock);
     return LUX_SUCCESS;
 }
 
@@ -436,21 +2499,49 @@ lux_error_t lux_consensus_get_preference(
         return LUX_ERROR_INVALID_PARAMS;
     }
     
-    pthread_rwlock_rdlock(&engine->rwlock);
-    
-    if (engine->preferred_block) {
-        memcpy(block_id, engine->preferred_block->block.id, 32);
-    } else {
-        memset(block_id, 0, 32);
-    }
-    
-    pthread_rwlock_unlock(&engine->rwlock);
+    read_preference(engine, block_id);
     return LUX_SUCCESS;
 }
 
 // Polling
 // [C-006] Maximum number of validators to prevent resource exhaustion
-#define LUX_MAX_VALIDATORS 10000
+// Snow sampling core: pick min(config.k, num_validators) distinct validator
+// indices by partial Fisher-Yates over the chain's scratch index pool, driven
+// by the per-chain xoshiro256** state. Caller must hold engine->poll_mutex.
+// Only the first poll (or a growth in validator-set size) allocates; the
+// steady state reuses the scratch.
+static lux_error_t poll_sample_locked(lux_chain_t* engine,
+                                      uint32_t num_validators,
+                                      uint32_t* out,
+                                      uint32_t* num_out) {
+    uint32_t k = engine->config.k > 0 ? engine->config.k : 1;
+    if (k > num_validators) k = num_validators;
+
+    if (engine->poll_scratch_capacity < num_validators) {
+        uint32_t* grown = (uint32_t*)realloc(
+            engine->poll_scratch, num_validators * sizeof(uint32_t));
+        if (!grown) {
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        engine->poll_scratch = grown;
+        engine->poll_scratch_capacity = num_validators;
+    }
+
+    uint32_t* pool = engine->poll_scratch;
+    for (uint32_t i = 0; i < num_validators; i++) {
+        pool[i] = i;
+    }
+    for (uint32_t i = 0; i < k; i++) {
+        uint32_t j = i + xoshiro_bounded(engine->prng_state,
+                                         num_validators - i);
+        uint32_t tmp = pool[i];
+        pool[i] = pool[j];
+        pool[j] = tmp;
+        out[i] = pool[i];
+    }
+    *num_out = k;
+    return LUX_SUCCESS;
+}
 
 lux_error_t lux_consensus_poll(
     lux_chain_t* engine,
@@ -466,16 +2557,87 @@ lux_error_t lux_consensus_poll(
         return LUX_ERROR_INVALID_PARAMS;
     }
 
+    pthread_mutex_lock(&engine->poll_mutex);
+
+    // Make sure the engine-internal result buffer can hold k indices
+    uint32_t k = engine->config.k > 0 ? engine->config.k : 1;
+    if (k > num_validators) k = num_validators;
+    if (engine->poll_sampled_capacity < k) {
+        uint32_t* grown = (uint32_t*)realloc(engine->poll_sampled,
+                                             k * sizeof(uint32_t));
+        if (!grown) {
+            pthread_mutex_unlock(&engine->poll_mutex);
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        engine->poll_sampled = grown;
+        engine->poll_sampled_capacity = k;
+    }
+
+    uint32_t num_sampled = 0;
+    lux_error_t err = poll_sample_locked(engine, num_validators,
+                                         engine->poll_sampled, &num_sampled);
+    pthread_mutex_unlock(&engine->poll_mutex);
+    if (err != LUX_SUCCESS) {
+        return err;
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+    engine->stats.polls_completed++;
+    pthread_mutex_unlock(&engine->mutex);
+    return LUX_SUCCESS;
+}
+
+// Sampling round with the query batch exposed: the network layer receives
+// which validators (as indices into its own validator_ids array) to contact
+// for the chain's current preference. sampled_indices must have room for
+// the effective k = min(config.k, num_validators) entries; the call is
+// allocation-free apart from one-time scratch growth inside the chain.
+lux_error_t lux_consensus_poll_ex(
+    lux_chain_t* engine,
+    uint32_t num_validators,
+    const uint8_t** validator_ids,
+    uint32_t* sampled_indices,
+    uint32_t* num_sampled,
+    uint8_t* block_id_out
+) {
+    if (!engine || !validator_ids || !sampled_indices || !num_sampled) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    if (num_validators == 0 || num_validators > LUX_MAX_VALIDATORS) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    pthread_mutex_lock(&engine->poll_mutex);
+    lux_error_t err = poll_sample_locked(engine, num_validators,
+                                         sampled_indices, num_sampled);
+    pthread_mutex_unlock(&engine->poll_mutex);
+    if (err != LUX_SUCCESS) {
+        return err;
+    }
+
+    if (block_id_out) {
+        read_preference(engine, block_id_out);
+    }
+
     pthread_mutex_lock(&engine->mutex);
-    
-    // Simulate polling validators (in real implementation, would do network calls)
-    // For now, just increment poll count
     engine->stats.polls_completed++;
-    
     pthread_mutex_unlock(&engine->mutex);
     return LUX_SUCCESS;
 }
 
+lux_error_t lux_consensus_poll_events(
+    lux_chain_t* engine,
+    lux_event_t* events_out,
+    size_t max_events,
+    size_t* num_out
+) {
+    if (!engine || !events_out || !num_out) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    *num_out = event_ring_poll(&engine->events, events_out, max_events);
+    return LUX_SUCCESS;
+}
+
 // Callback registration
 lux_error_t lux_consensus_register_decision_callback(
     lux_chain_t* engine,
@@ -528,26 +2690,180 @@ lux_error_t lux_consensus_register_notify_callback(
     return LUX_SUCCESS;
 }
 
-// Statistics
-lux_error_t lux_consensus_get_stats(
+// Statistics
+lux_error_t lux_consensus_get_stats(
+    lux_chain_t* engine,
+    lux_consensus_stats_t* stats
+) {
+    if (!engine || !stats) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    
+    pthread_rwlock_rdlock(&engine->rwlock);
+    memcpy(stats, &engine->stats, sizeof(lux_consensus_stats_t));
+    
+    // Calculate average decision time
+    uint64_t current_time = (uint64_t)time(NULL);
+    uint64_t elapsed = current_time - engine->start_time;
+    if (engine->stats.blocks_accepted > 0) {
+        stats->average_decision_time_ms = (double)(elapsed * 1000) / engine->stats.blocks_accepted;
+    }
+
+    pthread_rwlock_unlock(&engine->rwlock);
+    return LUX_SUCCESS;
+}
+
+// Extended instrumentation snapshot. Counter reads are relaxed: each value
+// is individually consistent, and a fleet dashboard does not need a single
+// atomic snapshot across all of them.
+lux_error_t lux_consensus_get_stats_ex(
+    lux_chain_t* engine,
+    lux_consensus_stats_ex_t* stats
+) {
+    if (!engine || !stats || stats->version != LUX_STATS_EX_VERSION) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    lux_error_t err = lux_consensus_get_stats(engine, &stats->base);
+    if (err != LUX_SUCCESS) {
+        return err;
+    }
+
+    stats->table_lookups =
+        atomic_load_explicit(&engine->table_lookups, memory_order_relaxed);
+    for (size_t i = 0; i < LUX_PROBE_HIST_BUCKETS; i++) {
+        stats->probe_histogram[i] =
+            atomic_load_explicit(&engine->probe_hist[i], memory_order_relaxed);
+    }
+    stats->tree_lock_wait_ns =
+        atomic_load_explicit(&engine->tree_lock_wait_ns, memory_order_relaxed);
+    stats->tree_lock_acquisitions =
+        atomic_load_explicit(&engine->tree_lock_acquisitions,
+                             memory_order_relaxed);
+    stats->cache_lock_wait_ns =
+        atomic_load_explicit(&engine->cache_lock_wait_ns, memory_order_relaxed);
+    stats->cache_lock_acquisitions =
+        atomic_load_explicit(&engine->cache_lock_acquisitions,
+                             memory_order_relaxed);
+    stats->vote_cache_evictions =
+        atomic_load_explicit(&engine->vote_cache_evictions,
+                             memory_order_relaxed);
+    stats->children_reallocs =
+        atomic_load_explicit(&engine->children_reallocs, memory_order_relaxed);
+
+    // Decision latency fields are written under the tree mutex
+    pthread_mutex_lock(&engine->mutex);
+    stats->decisions_measured = engine->decisions_measured;
+    stats->decision_latency_total_ns = engine->decision_latency_total_ns;
+    stats->decision_latency_max_ns = engine->decision_latency_max_ns;
+    pthread_mutex_unlock(&engine->mutex);
+
+    // Replace the seconds-based average with the true nanosecond one when
+    // measurements exist
+    if (stats->decisions_measured > 0) {
+        stats->base.average_decision_time_ms =
+            (double)stats->decision_latency_total_ns /
+            (double)stats->decisions_measured / 1e6;
+    }
+    return LUX_SUCCESS;
+}
+
+// Reconstruct a bucket's representative value (its lower bound, exact
+// below LAT_HIST_SUB).
+static uint64_t lat_hist_bucket_value(size_t idx) {
+    size_t major = idx / LAT_HIST_SUB;
+    size_t minor = idx % LAT_HIST_SUB;
+    if (major == 0) {
+        return (uint64_t)minor;
+    }
+    return ((uint64_t)(LAT_HIST_SUB + minor)) << (major - 1);
+}
+
+lux_error_t lux_consensus_get_decision_latency(
+    lux_chain_t* engine,
+    lux_latency_stats_t* stats
+) {
+    if (!engine || !stats) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    // Snapshot the buckets (relaxed: each counter individually consistent),
+    // then walk the cumulative distribution once for all three percentiles.
+    uint64_t counts[LAT_HIST_BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        counts[i] = atomic_load_explicit(&engine->lat_hist[i],
+                                         memory_order_relaxed);
+        total += counts[i];
+    }
+
+    stats->count = total;
+    stats->max_ns = atomic_load_explicit(&engine->lat_hist_max_ns,
+                                         memory_order_relaxed);
+    stats->p50_ns = 0;
+    stats->p99_ns = 0;
+    stats->p999_ns = 0;
+    if (total == 0) {
+        return LUX_SUCCESS;
+    }
+
+    uint64_t t50 = (total * 50 + 99) / 100;
+    uint64_t t99 = (total * 99 + 99) / 100;
+    uint64_t t999 = (total * 999 + 999) / 1000;
+    uint64_t cum = 0;
+    for (size_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        cum += counts[i];
+        uint64_t value = lat_hist_bucket_value(i);
+        if (!stats->p50_ns && cum >= t50) stats->p50_ns = value ? value : 1;
+        if (!stats->p99_ns && cum >= t99) stats->p99_ns = value ? value : 1;
+        if (!stats->p999_ns && cum >= t999) {
+            stats->p999_ns = value ? value : 1;
+            break;
+        }
+    }
+    if (stats->p999_ns > stats->max_ns && stats->max_ns) {
+        stats->p999_ns = stats->max_ns;
+    }
+    return LUX_SUCCESS;
+}
+
+static void mem_counter_read(const mem_counter_t* c, lux_memory_category_t* out) {
+    out->current = atomic_load_explicit(&c->current, memory_order_relaxed);
+    out->peak = atomic_load_explicit(&c->peak, memory_order_relaxed);
+}
+
+lux_error_t lux_chain_memory_usage(
     lux_chain_t* engine,
-    lux_consensus_stats_t* stats
+    lux_memory_stats_t* stats
 ) {
     if (!engine || !stats) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    pthread_rwlock_rdlock(&engine->rwlock);
-    memcpy(stats, &engine->stats, sizeof(lux_consensus_stats_t));
-    
-    // Calculate average decision time
-    uint64_t current_time = (uint64_t)time(NULL);
-    uint64_t elapsed = current_time - engine->start_time;
-    if (engine->stats.blocks_accepted > 0) {
-        stats->average_decision_time_ms = (double)(elapsed * 1000) / engine->stats.blocks_accepted;
-    }
-    
-    pthread_rwlock_unlock(&engine->rwlock);
+
+    // Block nodes live in the slab pool, which only ever grows: bytes held
+    // equal the chunk count times the chunk footprint, and current == peak.
+    uint64_t chunks = atomic_load_explicit(&engine->node_pool.chunk_count,
+                                           memory_order_relaxed);
+    uint64_t node_bytes = chunks *
+        (sizeof(slab_chunk_t) +
+         SLAB_CHUNK_OBJECTS * engine->node_pool.obj_size);
+    stats->block_nodes.current = node_bytes;
+    stats->block_nodes.peak = node_bytes;
+
+    mem_counter_read(&engine->mem_payloads, &stats->payloads);
+    mem_counter_read(&engine->mem_table_entries, &stats->table_entries);
+    mem_counter_read(&engine->mem_children, &stats->children_arrays);
+    mem_counter_read(&engine->mem_vote_cache, &stats->vote_cache);
+    mem_counter_read(&engine->mem_voter_state, &stats->voter_state);
+    mem_counter_read(&engine->mem_indexes, &stats->indexes);
+
+    stats->total_current = stats->block_nodes.current +
+                           stats->payloads.current +
+                           stats->table_entries.current +
+                           stats->children_arrays.current +
+                           stats->vote_cache.current +
+                           stats->voter_state.current +
+                           stats->indexes.current;
     return LUX_SUCCESS;
 }
 
@@ -560,10 +2876,20 @@ const char* lux_error_string(lux_error_t error) {
         case LUX_ERROR_INVALID_STATE: return "Invalid state";
         case LUX_ERROR_CONSENSUS_FAILED: return "Consensus failed";
         case LUX_ERROR_NOT_IMPLEMENTED: return "Not implemented";
+        case LUX_ERROR_QUEUE_FULL: return "Submission queue full";
         default: return "Unknown error";
     }
 }
 
+const char* lux_engine_type_string(lux_engine_type_t type) {
+    switch (type) {
+        case LUX_ENGINE_CHAIN: return "chain";
+        case LUX_ENGINE_DAG: return "dag";
+        case LUX_ENGINE_PQ: return "pq";
+        default: return "unknown";
+    }
+}
+
 // New v1.22.0 simplified API functions
 
 lux_chain_t* lux_chain_new_default(void) {
@@ -591,105 +2917,801 @@ lux_chain_t* lux_chain_new(const lux_config_t* config) {
     chain->config.k = config->k > 0 ? config->k : (config->node_count > 1 ? config->node_count / 2 : 1);
     chain->config.alpha = config->alpha > 0 ? config->alpha : (config->node_count > 1 ? (config->node_count * 2) / 3 : 1);
     chain->config.beta = config->beta > 0 ? config->beta : (config->node_count > 2 ? config->node_count - 2 : 1);
+    chain->config.vote_cache_capacity = config->vote_cache_capacity;
+    chain->config.expected_blocks = config->expected_blocks;
+    chain->config.expected_children_per_block = config->expected_children_per_block;
     
     // Initialize mutexes
     pthread_mutex_init(&chain->mutex, NULL);
+    pthread_mutex_init(&chain->cache_mutex, NULL);
     pthread_rwlock_init(&chain->rwlock, NULL);
-    
+    for (int i = 0; i < TABLE_SHARD_COUNT; i++) {
+        pthread_mutex_init(&chain->block_table[i].lock, NULL);
+    }
+    slab_init(&chain->node_pool, sizeof(block_node_t));
+    chain->vote_ring_capacity = config->vote_cache_capacity > 0
+        ? config->vote_cache_capacity : VOTE_CACHE_DEFAULT_CAPACITY;
+    if (config->expected_blocks > 0) {
+        table_presize(chain, config->expected_blocks);
+        slab_reserve(&chain->node_pool, config->expected_blocks);
+        chain->vote_ring = (vote_cache_t*)malloc(
+            chain->vote_ring_capacity * sizeof(vote_cache_t));
+        if (chain->vote_ring) {
+            mem_add(&chain->mem_vote_cache,
+                    chain->vote_ring_capacity * sizeof(vote_cache_t));
+        }
+    }
+    if (decision_queue_init(&chain->ready_decisions) != LUX_SUCCESS) {
+        slab_destroy(&chain->node_pool);
+        free(chain);
+        return NULL;
+    }
+    event_ring_init(&chain->events); // best-effort: OOM just disables events
+    pthread_mutex_init(&chain->poll_mutex, NULL);
+    pthread_mutex_init(&chain->voter_mutex, NULL);
+    xoshiro_seed(chain->prng_state,
+                 (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)chain ^ monotonic_ns());
+
     chain->start_time = (uint64_t)time(NULL);
-    
+
     // Note: block_table is already a static array in the struct, not allocated
-    
+
     return chain;
 }
 
+static lux_error_t chain_add_block_internal(lux_chain_t* chain,
+                                            const lux_block_t* block,
+                                            lux_callback_release release,
+                                            void* release_user_data);
+
+// Replay helper for lux_chain_open: records point into the mapping, which
+// moves when the log grows, so payloads are copied out before insertion.
+static void replayed_payload_release(void* data, size_t data_size,
+                                     void* user_data) {
+    (void)data_size;
+    (void)user_data;
+    free(data);
+}
+
+static lux_error_t block_log_replay_add(const lux_block_t* block, void* ctx) {
+    lux_chain_t* chain = (lux_chain_t*)ctx;
+    lux_block_t copy = *block;
+    if (copy.data_size > 0) {
+        copy.data = malloc(copy.data_size);
+        if (!copy.data) {
+            return LUX_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(copy.data, block->data, copy.data_size);
+    } else {
+        copy.data = NULL;
+    }
+    lux_error_t err = chain_add_block_internal(chain, &copy,
+                                               replayed_payload_release, NULL);
+    if (err != LUX_SUCCESS && copy.data) {
+        // add_block_owned semantics: internal path did not take ownership
+        free(copy.data);
+    }
+    return err;
+}
+
+lux_chain_t* lux_chain_open(const char* path, const lux_config_t* config) {
+    if (!path) {
+        return NULL;
+    }
+
+    lux_chain_t* chain = config ? lux_chain_new(config)
+                                : lux_chain_new_default();
+    if (!chain) {
+        return NULL;
+    }
+
+    block_log_t* log = (block_log_t*)calloc(1, sizeof(block_log_t));
+    if (!log) {
+        lux_chain_destroy(chain);
+        return NULL;
+    }
+    if (block_log_open(log, path) != LUX_SUCCESS) {
+        free(log);
+        lux_chain_destroy(chain);
+        return NULL;
+    }
+
+    // Replay before attaching the log so re-inserted blocks are not
+    // re-appended; decisions queued during replay are dropped rather than
+    // re-delivered to a fresh process with no registered callback yet.
+    if (block_log_replay(log, block_log_replay_add, chain) != LUX_SUCCESS) {
+        block_log_close(log);
+        free(log);
+        lux_chain_destroy(chain);
+        return NULL;
+    }
+    uint8_t scratch[32];
+    while (decision_queue_pop(&chain->ready_decisions, scratch)) {
+    }
+
+    chain->block_log = log;
+    return chain;
+}
+
+#define VOTE_WORKER_BATCH 256
+
+// Replay context for lux_consensus_attach_vote_journal: journaled votes are
+// batched and pushed through the regular batch-vote path, so replay gets the
+// same dedup, decision sweep, and lock amortization as live traffic.
+typedef struct {
+    lux_chain_t* chain;
+    lux_vote_t batch[VOTE_WORKER_BATCH];
+    size_t count;
+    size_t replayed;
+} journal_replay_ctx_t;
+
+static lux_error_t journal_replay_flush(journal_replay_ctx_t* ctx) {
+    if (ctx->count == 0) {
+        return LUX_SUCCESS;
+    }
+    // Per-vote failures (e.g. a vote for a block that was never re-added)
+    // are tolerated: the journal accelerates recovery, it does not gate it.
+    lux_error_t err = lux_consensus_process_votes(ctx->chain, ctx->batch,
+                                                  ctx->count, NULL);
+    ctx->replayed += ctx->count;
+    ctx->count = 0;
+    return err;
+}
+
+static lux_error_t journal_replay_vote(const lux_vote_t* vote, void* arg) {
+    journal_replay_ctx_t* ctx = (journal_replay_ctx_t*)arg;
+    ctx->batch[ctx->count++] = *vote;
+    if (ctx->count == VOTE_WORKER_BATCH) {
+        return journal_replay_flush(ctx);
+    }
+    return LUX_SUCCESS;
+}
+
+lux_error_t lux_consensus_attach_vote_journal(
+    lux_chain_t* engine,
+    const char* path,
+    size_t* replayed
+) {
+    if (!engine || !path) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    if (engine->vote_journal) {
+        return LUX_ERROR_INVALID_STATE; // already journaling
+    }
+
+    vote_journal_t* jl = (vote_journal_t*)calloc(1, sizeof(vote_journal_t));
+    if (!jl) {
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+    lux_error_t err = vote_journal_open(jl, path);
+    if (err != LUX_SUCCESS) {
+        free(jl);
+        return err;
+    }
+
+    // Replay the surviving records before taking new appends. The journal is
+    // attached first so journal_applied_vote restores per-node accounting,
+    // while journal_replaying keeps the already-durable records from being
+    // appended a second time.
+    engine->vote_journal = jl;
+    engine->journal_replaying = true;
+    journal_replay_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.chain = engine;
+    err = vote_journal_replay(jl, journal_replay_vote, &ctx);
+    if (err == LUX_SUCCESS) {
+        err = journal_replay_flush(&ctx);
+    }
+    engine->journal_replaying = false;
+    if (err != LUX_SUCCESS) {
+        engine->vote_journal = NULL;
+        vote_journal_close(jl);
+        free(jl);
+        return err;
+    }
+    if (replayed) {
+        *replayed = ctx.replayed;
+    }
+    return LUX_SUCCESS;
+}
+
+// A node can be pruned once it is decided, strictly below the requested
+// frontier, and all of its children are decided too — so surviving blocks
+// never lose a parent they still need for consensus. The current preference
+// and the genesis node always survive.
+static bool prune_eligible(lux_chain_t* chain, block_node_t* node,
+                           uint64_t below_height) {
+    if (!is_decided(node) || node->block.height >= below_height) {
+        return false;
+    }
+    // An unreported node may still sit on the deferred-decision list.
+    if (!node->decision_reported && atomic_load(&node->is_accepted)) {
+        return false;
+    }
+    if (node == chain->preferred_block || node == chain->genesis_block) {
+        return false;
+    }
+    for (size_t i = 0; i < node->children_count; i++) {
+        if (!is_decided(node->children[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+lux_error_t lux_chain_prune(
+    lux_chain_t* chain,
+    uint64_t below_height,
+    size_t* bytes_reclaimed
+) {
+    if (!chain) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    size_t reclaimed = 0;
+    pthread_mutex_lock(&chain->mutex);
+
+    // Phase 1: collect eligible nodes. Shard locks nest inside the tree
+    // mutex, same order as the add path.
+    block_node_t** doomed = NULL;
+    size_t doomed_count = 0;
+    size_t doomed_capacity = 0;
+    for (int sidx = 0; sidx < TABLE_SHARD_COUNT; sidx++) {
+        table_shard_t* shard = &chain->block_table[sidx];
+        pthread_mutex_lock(&shard->lock);
+        for (size_t i = 0; i < shard->capacity; i++) {
+            block_node_t* node = shard->entries[i].node;
+            if (!node || !prune_eligible(chain, node, below_height)) {
+                continue;
+            }
+            if (doomed_count == doomed_capacity) {
+                size_t new_capacity = doomed_capacity ? doomed_capacity * 2 : 256;
+                block_node_t** grown = (block_node_t**)realloc(
+                    doomed, new_capacity * sizeof(block_node_t*));
+                if (!grown) {
+                    break; // prune what we already collected
+                }
+                doomed = grown;
+                doomed_capacity = new_capacity;
+            }
+            doomed[doomed_count++] = node;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    // Phase 2: repair linkage while every node is still valid. Surviving
+    // parents lose the pruned child from their children array; surviving
+    // children of a pruned parent become roots.
+    for (size_t d = 0; d < doomed_count; d++) {
+        block_node_t* node = doomed[d];
+        conflict_set_remove(node);
+
+        block_node_t* parent = node->parent;
+        if (parent && !prune_eligible(chain, parent, below_height)) {
+            for (size_t i = 0; i < parent->children_count; i++) {
+                if (parent->children[i] == node) {
+                    parent->children[i] =
+                        parent->children[--parent->children_count];
+                    break;
+                }
+            }
+        }
+        for (size_t i = 0; i < node->children_count; i++) {
+            if (!prune_eligible(chain, node->children[i], below_height)) {
+                node->children[i]->parent = NULL;
+            }
+        }
+    }
+
+    // Phase 3: evict and free. Node structs return to the slab freelist,
+    // payloads and children arrays go back to the allocator.
+    for (size_t d = 0; d < doomed_count; d++) {
+        block_node_t* node = doomed[d];
+
+        uint32_t hash = hash_block_id(node->block.id);
+        table_shard_t* shard = shard_for(chain, hash);
+        pthread_mutex_lock(&shard->lock);
+        shard_remove(shard, hash, node->block.id);
+        pthread_mutex_unlock(&shard->lock);
+
+        if (node->block.height < chain->height_index_capacity &&
+            chain->height_index[node->block.height] == node) {
+            chain->height_index[node->block.height] = NULL;
+        }
+        event_ring_emit(&chain->events, LUX_EVENT_BLOCK_PRUNED,
+                        node->block.id, node->block.height);
+
+        if (node->block.data) {
+            reclaimed += node->block.data_size;
+        }
+        release_node_payload(chain, node);
+        reclaimed += node->children_capacity * sizeof(block_node_t*);
+        mem_sub(&chain->mem_children,
+                node->children_capacity * sizeof(block_node_t*));
+        free(node->children);
+        // Clear linkage before the node hits the freelist so nothing can
+        // follow stale pointers out of a recycled node.
+        node->children = NULL;
+        node->children_count = 0;
+        node->children_capacity = 0;
+        node->parent = NULL;
+        uint64_t* bits = atomic_load_explicit(&node->voter_bits,
+                                              memory_order_relaxed);
+        if (bits) {
+            reclaimed += 2 * VOTER_WORDS * sizeof(uint64_t);
+            mem_sub(&chain->mem_voter_state,
+                    2 * VOTER_WORDS * sizeof(uint64_t));
+            free(bits);
+        }
+        reclaimed += sizeof(block_node_t);
+        slab_free(&chain->node_pool, node);
+    }
+
+    free(doomed);
+    pthread_mutex_unlock(&chain->mutex);
+
+    if (bytes_reclaimed) {
+        *bytes_reclaimed = reclaimed;
+    }
+    return LUX_SUCCESS;
+}
+
 void lux_chain_destroy(lux_chain_t* chain) {
     if (!chain) {
         return;
     }
+
+    // Stop the vote pipeline if the caller skipped lux_chain_stop.
+    lux_chain_stop(chain);
+    vote_queue_free(&chain->submit_queue);
+    decision_queue_free(&chain->ready_decisions);
+    event_ring_free(&chain->events);
+    free(chain->deferred_decisions);
+    free(chain->height_index);
+    conflict_set_destroy_all(chain);
+    free(chain->poll_scratch);
+    free(chain->poll_sampled);
+    free(atomic_load_explicit(&chain->voter_reg, memory_order_relaxed));
+    pthread_mutex_destroy(&chain->voter_mutex);
+    pthread_mutex_destroy(&chain->poll_mutex);
+    if (chain->block_log) {
+        block_log_close(chain->block_log);
+        free(chain->block_log);
+        chain->block_log = NULL;
+    }
+    if (chain->vote_journal) {
+        vote_journal_close(chain->vote_journal);
+        free(chain->vote_journal);
+        chain->vote_journal = NULL;
+    }
     
-    // Free blocks in table
-    for (size_t i = 0; i < HASH_TABLE_SIZE; i++) {
-        hash_entry_t* entry = chain->block_table[i];
-        while (entry) {
-            hash_entry_t* next = entry->next;
-            if (entry->node) {
-                free(entry->node->children);
-                free(entry->node);
+    // Free per-node heap allocations; the nodes and cached votes themselves
+    // are reclaimed in bulk by the slab teardown below.
+    for (int s = 0; s < TABLE_SHARD_COUNT; s++) {
+        table_shard_t* shard = &chain->block_table[s];
+        for (size_t i = 0; i < shard->capacity; i++) {
+            block_node_t* node = shard->entries[i].node;
+            if (node) {
+                free(node->children);
+                free(atomic_load_explicit(&node->voter_bits,
+                                          memory_order_relaxed));
+                release_node_payload(chain, node);
             }
-            free(entry);
-            entry = next;
+        }
+        free(shard->entries);
+        while (shard->retired) {
+            retired_entries_t* r = shard->retired;
+            shard->retired = r->next;
+            free(r->entries);
+            free(r);
         }
     }
-    
-    // Free vote cache
-    vote_cache_t* vote = chain->vote_cache;
-    while (vote) {
-        vote_cache_t* next = vote->next;
-        free(vote);
-        vote = next;
-    }
-    
+
+    slab_destroy(&chain->node_pool);
+    free(chain->vote_ring);
+
     // Destroy mutexes
     pthread_mutex_destroy(&chain->mutex);
+    pthread_mutex_destroy(&chain->cache_mutex);
     pthread_rwlock_destroy(&chain->rwlock);
-    
+    for (int i = 0; i < TABLE_SHARD_COUNT; i++) {
+        pthread_mutex_destroy(&chain->block_table[i].lock);
+    }
+
     free(chain);
 }
 
+// Consumer side of the asynchronous vote pipeline: drains the submit queue
+// in batches and applies them through the shared batch-vote path. Spins
+// briefly when the queue runs dry, then parks for 100us, so an idle chain
+// costs effectively nothing.
+
+static void* vote_worker_main(void* arg) {
+    lux_chain_t* chain = (lux_chain_t*)arg;
+    lux_vote_t batch[VOTE_WORKER_BATCH];
+    unsigned idle_spins = 0;
+
+    for (;;) {
+        size_t n = vote_queue_pop_batch(&chain->submit_queue, batch,
+                                        VOTE_WORKER_BATCH);
+        if (n > 0) {
+            idle_spins = 0;
+            lux_consensus_process_votes(chain, batch, n, NULL);
+            continue;
+        }
+        if (!atomic_load_explicit(&chain->pipeline_running, memory_order_acquire)) {
+            // Stopped and fully drained.
+            return NULL;
+        }
+        if (++idle_spins < 64) {
+            sched_yield();
+        } else {
+            struct timespec park = {0, 100000}; // 100us
+            nanosleep(&park, NULL);
+        }
+    }
+}
+
 lux_error_t lux_chain_start(lux_chain_t* chain) {
     if (!chain) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
-    // Mark as started (chain is always "running" in simple mode)
+
     chain->start_time = (uint64_t)time(NULL);
-    
+
+    // The submit queue is strictly single-consumer; a dedicated pipeline
+    // thread would drain it concurrently with the group's workers.
+    if (atomic_load_explicit(&chain->in_group, memory_order_acquire)) {
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    // Idempotent: the pipeline thread is created once per start/stop cycle.
+    if (chain->worker_started) {
+        return LUX_SUCCESS;
+    }
+
+    if (!chain->submit_queue.cells) {
+        lux_error_t err = vote_queue_init(&chain->submit_queue, VOTE_QUEUE_CAPACITY);
+        if (err != LUX_SUCCESS) {
+            return err;
+        }
+    }
+
+    atomic_store_explicit(&chain->pipeline_running, true, memory_order_release);
+    if (pthread_create(&chain->vote_worker, NULL, vote_worker_main, chain) != 0) {
+        atomic_store_explicit(&chain->pipeline_running, false, memory_order_release);
+        return LUX_ERROR_INVALID_STATE;
+    }
+    chain->worker_started = true;
     return LUX_SUCCESS;
 }
 
 void lux_chain_stop(lux_chain_t* chain) {
-    // No-op in simple implementation
-    // Chain can be stopped by destroying it
-    (void)chain;
+    if (!chain || !chain->worker_started) {
+        return;
+    }
+
+    // Stop accepting submissions; the worker drains what is already queued
+    // before exiting, so no accepted vote is lost.
+    atomic_store_explicit(&chain->pipeline_running, false, memory_order_release);
+    pthread_join(chain->vote_worker, NULL);
+    chain->worker_started = false;
 }
 
-lux_error_t lux_chain_add_block(lux_chain_t* chain, const lux_block_t* block) {
+// ---------------------------------------------------------------------------
+// Engine groups: a shared worker pool multiplexed across many chains. Slots
+// are a fixed array of atomic pointers (like the voter registry), so the
+// workers' scan takes no lock; registration claims a slot with a CAS. A
+// worker takes exclusive hold of one chain at a time via group_claimed, so
+// two workers never drain the same queue concurrently while distinct hot
+// chains are drained in parallel.
+// ---------------------------------------------------------------------------
+
+#define GROUP_MAX_CHAINS 256
+#define GROUP_MAX_WORKERS 32
+
+struct lux_engine_group {
+    _Atomic(lux_chain_t*) chains[GROUP_MAX_CHAINS];
+    pthread_t workers[GROUP_MAX_WORKERS];
+    uint32_t num_workers;
+    _Atomic bool running;
+    _Atomic uint32_t scan_cursor; // rotating start offset per pass
+};
+
+// Drain one batch from a chain if it is unclaimed. Returns true when votes
+// were processed.
+static bool group_drain_chain(lux_chain_t* chain) {
+    if (atomic_exchange(&chain->group_claimed, true)) {
+        return false; // another worker holds it
+    }
+    lux_vote_t batch[VOTE_WORKER_BATCH];
+    bool worked = false;
+    size_t n = vote_queue_pop_batch(&chain->submit_queue, batch,
+                                    VOTE_WORKER_BATCH);
+    if (n > 0) {
+        lux_consensus_process_votes(chain, batch, n, NULL);
+        worked = true;
+    }
+    atomic_store(&chain->group_claimed, false);
+    return worked;
+}
+
+static void* group_worker_main(void* arg) {
+    lux_engine_group_t* group = (lux_engine_group_t*)arg;
+    unsigned idle_spins = 0;
+
+    for (;;) {
+        // Start each sweep at a rotating offset so workers fan out across
+        // hot chains instead of piling onto slot 0.
+        uint32_t start = atomic_fetch_add_explicit(&group->scan_cursor, 1,
+                                                   memory_order_relaxed);
+        bool worked = false;
+        for (uint32_t i = 0; i < GROUP_MAX_CHAINS; i++) {
+            lux_chain_t* chain = atomic_load_explicit(
+                &group->chains[(start + i) % GROUP_MAX_CHAINS],
+                memory_order_acquire);
+            if (chain && group_drain_chain(chain)) {
+                worked = true;
+            }
+        }
+        if (worked) {
+            idle_spins = 0;
+            continue;
+        }
+        if (!atomic_load_explicit(&group->running, memory_order_acquire)) {
+            return NULL; // stopped and the final sweep found nothing
+        }
+        if (++idle_spins < 64) {
+            sched_yield();
+        } else {
+            struct timespec park = {0, 100000}; // 100us
+            nanosleep(&park, NULL);
+        }
+    }
+}
+
+lux_engine_group_t* lux_engine_group_new(uint32_t num_workers) {
+    if (num_workers == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cores > 1 ? (uint32_t)(cores / 2) : 1;
+    }
+    if (num_workers > GROUP_MAX_WORKERS) {
+        num_workers = GROUP_MAX_WORKERS;
+    }
+
+    lux_engine_group_t* group =
+        (lux_engine_group_t*)calloc(1, sizeof(lux_engine_group_t));
+    if (!group) {
+        return NULL;
+    }
+    group->num_workers = num_workers;
+    atomic_store_explicit(&group->running, true, memory_order_release);
+
+    for (uint32_t i = 0; i < num_workers; i++) {
+        if (pthread_create(&group->workers[i], NULL, group_worker_main,
+                           group) != 0) {
+            atomic_store_explicit(&group->running, false,
+                                  memory_order_release);
+            for (uint32_t j = 0; j < i; j++) {
+                pthread_join(group->workers[j], NULL);
+            }
+            free(group);
+            return NULL;
+        }
+    }
+    return group;
+}
+
+lux_error_t lux_engine_group_add(lux_engine_group_t* group,
+                                 lux_chain_t* chain) {
+    if (!group || !chain) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    if (chain->worker_started) {
+        return LUX_ERROR_INVALID_STATE; // already runs its own pipeline
+    }
+    // Claim group membership first; lux_chain_start checks this flag, so a
+    // racing start can never spawn a second consumer of the submit queue.
+    if (atomic_exchange(&chain->in_group, true)) {
+        return LUX_ERROR_INVALID_STATE; // already registered with a group
+    }
+    if (!chain->submit_queue.cells) {
+        lux_error_t err = vote_queue_init(&chain->submit_queue,
+                                          VOTE_QUEUE_CAPACITY);
+        if (err != LUX_SUCCESS) {
+            atomic_store(&chain->in_group, false);
+            return err;
+        }
+    }
+    // Accept submissions before the slot is published: a worker that sees
+    // the chain must see a live queue.
+    atomic_store_explicit(&chain->pipeline_running, true,
+                          memory_order_release);
+
+    for (uint32_t i = 0; i < GROUP_MAX_CHAINS; i++) {
+        lux_chain_t* expected = NULL;
+        if (atomic_compare_exchange_strong(&group->chains[i], &expected,
+                                           chain)) {
+            return LUX_SUCCESS;
+        }
+        if (expected == chain) {
+            return LUX_ERROR_INVALID_STATE; // already registered
+        }
+    }
+    atomic_store_explicit(&chain->pipeline_running, false,
+                          memory_order_release);
+    atomic_store(&chain->in_group, false);
+    return LUX_ERROR_INVALID_STATE; // group full
+}
+
+lux_error_t lux_engine_group_remove(lux_engine_group_t* group,
+                                    lux_chain_t* chain) {
+    if (!group || !chain) {
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+    bool found = false;
+    for (uint32_t i = 0; i < GROUP_MAX_CHAINS; i++) {
+        lux_chain_t* expected = chain;
+        if (atomic_compare_exchange_strong(&group->chains[i], &expected,
+                                           NULL)) {
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    // Stop accepting new submissions, wait out any worker mid-batch on this
+    // chain, then drain what is already queued so no accepted vote is lost.
+    atomic_store_explicit(&chain->pipeline_running, false,
+                          memory_order_release);
+    while (atomic_exchange(&chain->group_claimed, true)) {
+        sched_yield();
+    }
+    lux_vote_t batch[VOTE_WORKER_BATCH];
+    size_t n;
+    while ((n = vote_queue_pop_batch(&chain->submit_queue, batch,
+                                     VOTE_WORKER_BATCH)) > 0) {
+        lux_consensus_process_votes(chain, batch, n, NULL);
+    }
+    atomic_store(&chain->group_claimed, false);
+    atomic_store(&chain->in_group, false);
+    return LUX_SUCCESS;
+}
+
+void lux_engine_group_destroy(lux_engine_group_t* group) {
+    if (!group) {
+        return;
+    }
+    atomic_store_explicit(&group->running, false, memory_order_release);
+    for (uint32_t i = 0; i < group->num_workers; i++) {
+        pthread_join(group->workers[i], NULL);
+    }
+    // Drain and release every chain still registered; the chains themselves
+    // belong to the caller.
+    for (uint32_t i = 0; i < GROUP_MAX_CHAINS; i++) {
+        lux_chain_t* chain = atomic_load_explicit(&group->chains[i],
+                                                  memory_order_acquire);
+        if (!chain) {
+            continue;
+        }
+        atomic_store_explicit(&group->chains[i], NULL, memory_order_release);
+        atomic_store_explicit(&chain->pipeline_running, false,
+                              memory_order_release);
+        lux_vote_t batch[VOTE_WORKER_BATCH];
+        size_t n;
+        while ((n = vote_queue_pop_batch(&chain->submit_queue, batch,
+                                         VOTE_WORKER_BATCH)) > 0) {
+            lux_consensus_process_votes(chain, batch, n, NULL);
+        }
+    }
+    free(group);
+}
+
+static lux_error_t chain_add_block_internal(lux_chain_t* chain,
+                                            const lux_block_t* block,
+                                            lux_callback_release release,
+                                            void* release_user_data) {
     if (!chain || !block) {
         return LUX_ERROR_INVALID_PARAMS;
     }
-    
+
+    // Verification runs before any engine state is touched and outside all
+    // locks; concurrent adders verify in parallel. Replay from a block log
+    // skips this naturally: callbacks cannot be registered before
+    // lux_chain_open returns.
+    if (chain->verify_callback) {
+        if (!chain->verify_callback(block, chain->callback_user_data)) {
+            return LUX_ERROR_CONSENSUS_FAILED;
+        }
+    }
+
     // Create block node
-    block_node_t* node = (block_node_t*)calloc(1, sizeof(block_node_t));
+    block_node_t* node = (block_node_t*)slab_alloc(&chain->node_pool);
     if (!node) {
         return LUX_ERROR_OUT_OF_MEMORY;
     }
-    
-    // Copy block data
+
+    // Copy block header; the payload pointer is stored as-is (zero-copy).
     memcpy(&node->block, block, sizeof(lux_block_t));
+    node->added_ns = monotonic_ns();
+    node->data_release = release;
+    node->data_release_ctx = release_user_data;
+    if (release && block->data) {
+        // Owned payloads count against the engine until release fires.
+        mem_add(&chain->mem_payloads, block->data_size);
+    }
     node->is_processing = true;
-    
+
     // Add to hash table
     lux_error_t err = add_block_to_table(chain, node);
     if (err != LUX_SUCCESS) {
-        free(node);
+        slab_free(&chain->node_pool, node);
         return err;
     }
-    
+
     // Update stats
     pthread_rwlock_wrlock(&chain->rwlock);
     chain->stats.votes_processed++;
     chain->stats.blocks_accepted++;
     pthread_rwlock_unlock(&chain->rwlock);
     
-    // Mark as accepted (simplified consensus)
-    node->is_accepted = true;
+    // Mark as accepted (simplified consensus); release pairs with the
+    // acquire load in lux_consensus_is_accepted's lock-free path
+    atomic_store_explicit(&node->is_accepted, true, memory_order_release);
+    raise_finalized_height(chain, node->block.height);
+    record_decision_latency(chain, monotonic_ns() - node->added_ns);
+    event_ring_emit(&chain->events, LUX_EVENT_BLOCK_ACCEPTED,
+                    node->block.id, node->block.height);
     node->is_processing = false;
     
-    // Trigger callback if set
-    if (chain->decision_callback) {
-        chain->decision_callback(block->id, chain->callback_user_data);
+    // Persist if this chain is backed by a block log
+    if (chain->block_log) {
+        block_log_append(chain->block_log, node->block.id,
+                         node->block.parent_id, node->block.height,
+                         node->block.timestamp, node->block.data,
+                         node->block.data_size);
     }
-    
+
+    // Resolve and link the parent if it is resident, so decision delivery
+    // can hold this block back until the parent has been reported (pipelined
+    // submission keeps whole chains in flight at once) and prune can repair
+    // linkage through the children array. An unknown parent leaves the block
+    // an unordered root, as before; so does a failed link, since a parent
+    // pointer without a children backlink would dangle after a prune.
+    pthread_mutex_lock(&chain->mutex);
+    node->parent = find_block(chain, block->parent_id);
+    if (link_child(chain, node) != LUX_SUCCESS) {
+        node->parent = NULL;
+    }
+
+    // Queue the decision (parent before child) and deliver it outside any
+    // engine locks
+    height_index_set(chain, node);
+    enqueue_decision_ordered(chain, node);
+    pthread_mutex_unlock(&chain->mutex);
+    deliver_decisions(chain);
+
     return LUX_SUCCESS;
 }
+
+lux_error_t lux_chain_add_block(lux_chain_t* chain, const lux_block_t* block) {
+    return chain_add_block_internal(chain, block, NULL, NULL);
+}
+
+lux_error_t lux_chain_add_block_owned(
+    lux_chain_t* chain,
+    const lux_block_t* block,
+    lux_callback_release release,
+    void* release_user_data
+) {
+    lux_error_t err = chain_add_block_internal(chain, block, release,
+                                               release_user_data);
+    if (err != LUX_SUCCESS && release && block) {
+        // The engine never took ownership; hand the buffer back so the
+        // caller is not left guessing who frees it.
+        release(block->data, block->data_size, release_user_data);
+    }
+    return err;
+}
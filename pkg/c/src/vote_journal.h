@@ -0,0 +1,266 @@
+// Copyright (C) 2019-2025, Lux Industries Inc. All rights reserved.
+// See the file LICENSE for licensing terms.
+//
+// Write-ahead vote journal. Applied votes are appended as fixed-size
+// checksummed records through a double-buffered writer: the hot path memcpys
+// into the active in-memory buffer under a short lock, and group commit
+// (vote_journal_commit, one write(2) plus one fdatasync per batch) swaps
+// buffers so the sync never blocks appenders. When every journaled vote
+// references a decided block the journal is truncated back to its header; on
+// restart the valid prefix is scanned and replayed through the batch-vote
+// path, restoring preference/confidence counts without re-gathering rounds
+// from the network. A torn tail (crash mid-write) is detected by the record
+// checksum and clipped, same as the block log.
+// Internal header, included by consensus_engine.c only.
+
+#ifndef LUX_VOTE_JOURNAL_H
+#define LUX_VOTE_JOURNAL_H
+
+#include <lux_consensus.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define VOTE_JOURNAL_MAGIC   0x314C4A56u  // "VJL1", little-endian
+#define VOTE_JOURNAL_VERSION 1u
+#define VOTE_JOURNAL_BUF_RECORDS 1024u    // per buffer, two buffers
+
+#define VOTE_JOURNAL_FLAG_PREFERENCE 0x1u
+
+// 16-byte file header at offset 0, same shape as the block log's
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+} vote_journal_file_header_t;
+
+// Fixed-size record; checksum covers everything before it, so an all-zero
+// region (preallocated or torn) never validates.
+typedef struct {
+    uint8_t block_id[32];
+    uint8_t voter_id[32];
+    uint32_t flags;
+    uint32_t checksum;
+} vote_journal_record_t;
+
+typedef struct {
+    int fd;
+    // Double buffer: appenders fill buf[active] under append_lock while a
+    // committer drains the other side under io_lock. Each buffer holds
+    // VOTE_JOURNAL_BUF_RECORDS records.
+    vote_journal_record_t* buf[2];
+    size_t used[2];
+    int active;
+    pthread_mutex_t append_lock;
+    pthread_mutex_t io_lock;        // serializes write + fdatasync + truncate
+    size_t file_end;                // durable append offset
+    // Journaled votes whose block has not decided yet; when this reaches
+    // zero the whole journal is garbage and gets truncated.
+    _Atomic uint64_t outstanding;
+} vote_journal_t;
+
+// FNV-1a over the record body; guards against torn writes, not adversaries
+static uint32_t vote_journal_checksum(const vote_journal_record_t* rec) {
+    uint32_t h = 0x811C9DC5u;
+    const uint8_t* p = (const uint8_t*)rec;
+    size_t body = offsetof(vote_journal_record_t, checksum);
+    for (size_t i = 0; i < body; i++) {
+        h = (h ^ p[i]) * 0x01000193u;
+    }
+    return h;
+}
+
+// Open (creating if needed) the journal at path and position the append
+// offset after the last valid record. A bad magic is an error; a bad record
+// ends the scan, clipping any torn tail.
+static lux_error_t vote_journal_open(vote_journal_t* jl, const char* path) {
+    memset(jl, 0, sizeof(*jl));
+    pthread_mutex_init(&jl->append_lock, NULL);
+    pthread_mutex_init(&jl->io_lock, NULL);
+
+    jl->buf[0] = (vote_journal_record_t*)malloc(
+        VOTE_JOURNAL_BUF_RECORDS * sizeof(vote_journal_record_t));
+    jl->buf[1] = (vote_journal_record_t*)malloc(
+        VOTE_JOURNAL_BUF_RECORDS * sizeof(vote_journal_record_t));
+    if (!jl->buf[0] || !jl->buf[1]) {
+        free(jl->buf[0]);
+        free(jl->buf[1]);
+        return LUX_ERROR_OUT_OF_MEMORY;
+    }
+
+    jl->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (jl->fd < 0) {
+        free(jl->buf[0]);
+        free(jl->buf[1]);
+        return LUX_ERROR_INVALID_PARAMS;
+    }
+
+    struct stat st;
+    if (fstat(jl->fd, &st) != 0) {
+        close(jl->fd);
+        free(jl->buf[0]);
+        free(jl->buf[1]);
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    vote_journal_file_header_t hdr;
+    if ((size_t)st.st_size < sizeof(hdr)) {
+        hdr.magic = VOTE_JOURNAL_MAGIC;
+        hdr.version = VOTE_JOURNAL_VERSION;
+        hdr.reserved = 0;
+        if (pwrite(jl->fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr)) {
+            close(jl->fd);
+            free(jl->buf[0]);
+            free(jl->buf[1]);
+            return LUX_ERROR_INVALID_STATE;
+        }
+        jl->file_end = sizeof(hdr);
+        return LUX_SUCCESS;
+    }
+
+    if (pread(jl->fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr) ||
+        hdr.magic != VOTE_JOURNAL_MAGIC ||
+        hdr.version != VOTE_JOURNAL_VERSION) {
+        close(jl->fd);
+        free(jl->buf[0]);
+        free(jl->buf[1]);
+        return LUX_ERROR_INVALID_STATE;
+    }
+
+    // Sequential scan to find the end of the valid prefix
+    size_t off = sizeof(hdr);
+    vote_journal_record_t rec;
+    while (off + sizeof(rec) <= (size_t)st.st_size) {
+        if (pread(jl->fd, &rec, sizeof(rec), (off_t)off) !=
+            (ssize_t)sizeof(rec)) {
+            break;
+        }
+        if (vote_journal_checksum(&rec) != rec.checksum) {
+            break; // torn or corrupt record
+        }
+        off += sizeof(rec);
+    }
+    jl->file_end = off;
+    return LUX_SUCCESS;
+}
+
+// Append one applied vote to the active buffer. Never touches the file;
+// durability comes from the next vote_journal_commit. If the buffer is full
+// the caller-side commit has fallen behind a whole batch, so flush inline.
+static void vote_journal_commit(vote_journal_t* jl);
+
+static void vote_journal_append(vote_journal_t* jl, const lux_vote_t* vote) {
+    pthread_mutex_lock(&jl->append_lock);
+    if (jl->used[jl->active] == VOTE_JOURNAL_BUF_RECORDS) {
+        pthread_mutex_unlock(&jl->append_lock);
+        vote_journal_commit(jl);
+        pthread_mutex_lock(&jl->append_lock);
+    }
+    vote_journal_record_t* rec = &jl->buf[jl->active][jl->used[jl->active]++];
+    memcpy(rec->block_id, vote->block_id, 32);
+    memcpy(rec->voter_id, vote->voter_id, 32);
+    rec->flags = vote->is_preference ? VOTE_JOURNAL_FLAG_PREFERENCE : 0;
+    rec->checksum = vote_journal_checksum(rec);
+    pthread_mutex_unlock(&jl->append_lock);
+}
+
+// Group commit: swap buffers (appenders continue on the other side), then
+// write the filled one and fdatasync once. One sync per batch, not per vote.
+static void vote_journal_commit(vote_journal_t* jl) {
+    pthread_mutex_lock(&jl->io_lock);
+
+    pthread_mutex_lock(&jl->append_lock);
+    int filled = jl->active;
+    size_t n = jl->used[filled];
+    if (n == 0) {
+        pthread_mutex_unlock(&jl->append_lock);
+        pthread_mutex_unlock(&jl->io_lock);
+        return;
+    }
+    jl->active = 1 - filled;
+    pthread_mutex_unlock(&jl->append_lock);
+
+    size_t bytes = n * sizeof(vote_journal_record_t);
+    if (pwrite(jl->fd, jl->buf[filled], bytes, (off_t)jl->file_end) ==
+        (ssize_t)bytes) {
+        jl->file_end += bytes;
+#ifdef __APPLE__
+        fsync(jl->fd);
+#else
+        fdatasync(jl->fd);
+#endif
+    }
+    // On a short write the records are dropped: the journal is a recovery
+    // accelerator, not the source of truth, so losing it costs re-gathering
+    // rounds, never correctness.
+    jl->used[filled] = 0;
+
+    pthread_mutex_unlock(&jl->io_lock);
+}
+
+// Drop everything: every journaled vote references a decided block, so the
+// whole file is garbage. Called from the decision path, where it is rare.
+static void vote_journal_truncate(vote_journal_t* jl) {
+    pthread_mutex_lock(&jl->io_lock);
+    pthread_mutex_lock(&jl->append_lock);
+    jl->used[0] = 0;
+    jl->used[1] = 0;
+    pthread_mutex_unlock(&jl->append_lock);
+
+    if (ftruncate(jl->fd, (off_t)sizeof(vote_journal_file_header_t)) == 0) {
+        jl->file_end = sizeof(vote_journal_file_header_t);
+    }
+    pthread_mutex_unlock(&jl->io_lock);
+}
+
+// Iterate the valid on-disk prefix in append order. Used by replay, before
+// the journal starts taking new appends.
+typedef lux_error_t (*vote_journal_replay_fn)(const lux_vote_t* vote,
+                                              void* ctx);
+
+static lux_error_t vote_journal_replay(vote_journal_t* jl,
+                                       vote_journal_replay_fn fn, void* ctx) {
+    size_t off = sizeof(vote_journal_file_header_t);
+    vote_journal_record_t rec;
+    while (off + sizeof(rec) <= jl->file_end) {
+        if (pread(jl->fd, &rec, sizeof(rec), (off_t)off) !=
+            (ssize_t)sizeof(rec)) {
+            break;
+        }
+        lux_vote_t vote;
+        memcpy(vote.block_id, rec.block_id, 32);
+        memcpy(vote.voter_id, rec.voter_id, 32);
+        vote.is_preference = (rec.flags & VOTE_JOURNAL_FLAG_PREFERENCE) != 0;
+        lux_error_t err = fn(&vote, ctx);
+        if (err != LUX_SUCCESS) {
+            return err;
+        }
+        off += sizeof(rec);
+    }
+    return LUX_SUCCESS;
+}
+
+// Flush pending buffers and close. The file keeps its records: a clean
+// shutdown mid-round replays exactly like a crash would.
+static void vote_journal_close(vote_journal_t* jl) {
+    vote_journal_commit(jl);
+    vote_journal_commit(jl); // both sides, in case a swap raced the first
+    if (jl->fd >= 0) {
+        close(jl->fd);
+        jl->fd = -1;
+    }
+    free(jl->buf[0]);
+    free(jl->buf[1]);
+    jl->buf[0] = NULL;
+    jl->buf[1] = NULL;
+    pthread_mutex_destroy(&jl->append_lock);
+    pthread_mutex_destroy(&jl->io_lock);
+}
+
+#endif // LUX_VOTE_JOURNAL_H
@@ -6,6 +6,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// Engine-path entry points: exported for the language bindings but not in
+// the public header. Unlike lux_chain_add_block, blocks added this way stay
+// undecided until votes cross beta, which the vote-journal test needs.
+extern lux_error_t lux_consensus_engine_create(lux_chain_t** engine_ptr,
+                                               const lux_config_t* config);
+extern lux_error_t lux_consensus_engine_destroy(lux_chain_t* engine);
+extern lux_error_t lux_consensus_add_block(lux_chain_t* engine,
+                                           const lux_block_t* block);
 
 // ANSI color codes
 #define COLOR_RESET   "\033[0m"
@@ -17,6 +29,16 @@
 static int tests_passed = 0;
 static int tests_failed = 0;
 
+// Counts payload releases from the zero-copy add path
+static int payloads_released = 0;
+
+static void owned_release(void* data, size_t data_size, void* user_data) {
+    (void)data_size;
+    (void)user_data;
+    free(data);
+    payloads_released++;
+}
+
 #define ASSERT_TEST(condition, test_name) do { \
     if (condition) { \
         printf("%s[PASS]%s %s\n", COLOR_GREEN, COLOR_RESET, test_name); \
@@ -28,6 +50,23 @@ static int tests_failed = 0;
     } \
 } while(0)
 
+static uint64_t last_visited_height = 0;
+static bool iterate_in_order = true;
+
+static bool visit_count_ordered(const lux_block_t* block, void* user_data) {
+    (void)user_data;
+    if (block->height <= last_visited_height) {
+        iterate_in_order = false;
+    }
+    last_visited_height = block->height;
+    return true;
+}
+
+static bool reject_bd_blocks(const lux_block_t* block, void* user_data) {
+    (void)user_data;
+    return block->id[0] != 0xBD;
+}
+
 int main(void) {
     printf("\n%s=== Lux Consensus C SDK Tests (v1.22.0) ===%s\n", COLOR_YELLOW, COLOR_RESET);
     
@@ -74,6 +113,18 @@ int main(void) {
     
     err = lux_chain_add_block(chain, &block);
     ASSERT_TEST(err == LUX_SUCCESS, "Add block to chain");
+
+    // Zero-copy variant: engine takes ownership and releases at teardown
+    lux_block_t owned_block;
+    memset(&owned_block, 0, sizeof(owned_block));
+    memset(owned_block.id, 0xAB, 32);
+    owned_block.height = 2;
+    owned_block.data_size = 64;
+    owned_block.data = malloc(owned_block.data_size);
+    ASSERT_TEST(owned_block.data != NULL, "Allocate owned payload");
+
+    err = lux_chain_add_block_owned(chain, &owned_block, owned_release, NULL);
+    ASSERT_TEST(err == LUX_SUCCESS, "Add block with owned payload");
     
     // Test 5: Create chain with custom config
     printf("\n%s--- Test 5: Custom Configuration ---%s\n", COLOR_YELLOW, COLOR_RESET);
@@ -89,12 +140,630 @@ int main(void) {
     
     err = lux_chain_start(custom_chain);
     ASSERT_TEST(err == LUX_SUCCESS, "Start custom chain");
+
+    // Sampling round: k=3 distinct validators drawn from a set of 5
+    uint8_t validator_ids[5][32];
+    const uint8_t* validator_ptrs[5];
+    for (int i = 0; i < 5; i++) {
+        memset(validator_ids[i], (uint8_t)(0x10 + i), 32);
+        validator_ptrs[i] = validator_ids[i];
+    }
+    uint32_t sampled[3] = {0};
+    uint32_t num_sampled = 0;
+    uint8_t poll_pref[32];
+    err = lux_consensus_poll_ex(custom_chain, 5, validator_ptrs,
+                                sampled, &num_sampled, poll_pref);
+    ASSERT_TEST(err == LUX_SUCCESS && num_sampled == 3, "Poll samples k validators");
+
+    bool sample_valid = true;
+    for (int i = 0; i < 3 && sample_valid; i++) {
+        if (sampled[i] >= 5) sample_valid = false;
+        for (int j = i + 1; j < 3; j++) {
+            if (sampled[i] == sampled[j]) sample_valid = false;
+        }
+    }
+    ASSERT_TEST(sample_valid, "Sampled indices distinct and in range");
     
-    // Test 6: Cleanup
-    printf("\n%s--- Test 6: Cleanup ---%s\n", COLOR_YELLOW, COLOR_RESET);
+    // Test 6: Batch vote processing
+    printf("\n%s--- Test 6: Batch Vote Processing ---%s\n", COLOR_YELLOW, COLOR_RESET);
+    lux_vote_t votes[8];
+    lux_error_t results[8];
+    memset(votes, 0, sizeof(votes));
+    for (int i = 0; i < 8; i++) {
+        memcpy(votes[i].block_id, block.id, 32);
+        votes[i].voter_id[0] = (uint8_t)(i + 1);
+        votes[i].is_preference = (i % 2 == 0);
+    }
+    // Last vote targets an unknown block and must fail individually
+    memset(votes[7].block_id, 0xFF, 32);
+
+    err = lux_consensus_process_votes(chain, votes, 8, results);
+    ASSERT_TEST(err == LUX_SUCCESS, "Process vote batch");
+    ASSERT_TEST(results[0] == LUX_SUCCESS, "First vote in batch succeeded");
+    ASSERT_TEST(results[7] == LUX_ERROR_INVALID_STATE, "Vote for unknown block rejected");
+
+    lux_consensus_stats_t batch_stats;
+    err = lux_consensus_get_stats(chain, &batch_stats);
+    ASSERT_TEST(err == LUX_SUCCESS && batch_stats.votes_processed >= 7,
+                "Batch votes counted in stats");
+
+    // Replayed votes are suppressed: the same (voter, block, kind) tuple
+    // counts once no matter how often it arrives
+    lux_vote_t replay;
+    memset(&replay, 0, sizeof(replay));
+    memcpy(replay.block_id, block.id, 32);
+    replay.voter_id[0] = 0xAB;
+    replay.is_preference = true;
+    for (int i = 0; i < 5; i++) {
+        err = lux_consensus_process_vote(chain, &replay);
+        if (err != LUX_SUCCESS) break;
+    }
+    ASSERT_TEST(err == LUX_SUCCESS, "Replayed votes accepted without error");
+    lux_consensus_stats_t dedup_stats;
+    lux_consensus_get_stats(chain, &dedup_stats);
+    ASSERT_TEST(dedup_stats.votes_processed == batch_stats.votes_processed + 1,
+                "Duplicate votes counted once");
+    // Same voter, other vote kind: a fresh tuple, so it counts
+    replay.is_preference = false;
+    err = lux_consensus_process_vote(chain, &replay);
+    lux_consensus_get_stats(chain, &dedup_stats);
+    ASSERT_TEST(err == LUX_SUCCESS &&
+                dedup_stats.votes_processed == batch_stats.votes_processed + 2,
+                "Confidence vote from same voter counted");
+
+    // Extended instrumentation: lookups above ran through find_block
+    lux_consensus_stats_ex_t stats_ex;
+    memset(&stats_ex, 0, sizeof(stats_ex));
+    stats_ex.version = LUX_STATS_EX_VERSION;
+    err = lux_consensus_get_stats_ex(chain, &stats_ex);
+    ASSERT_TEST(err == LUX_SUCCESS && stats_ex.table_lookups > 0,
+                "Extended stats populated");
+    stats_ex.version = 99;
+    ASSERT_TEST(lux_consensus_get_stats_ex(chain, &stats_ex) == LUX_ERROR_INVALID_PARAMS,
+                "Extended stats rejects unknown version");
+
+    // Binary vote frame: 3 voters, one group for the known block, applied
+    // straight from the wire buffer
+    {
+        uint8_t frame[8 + 3 * 32 + 34 + 3 * 2];
+        size_t off = 0;
+        uint32_t magic = LUX_VOTE_FRAME_MAGIC;
+        memcpy(frame + off, &magic, 4); off += 4;
+        uint16_t n16 = 3; memcpy(frame + off, &n16, 2); off += 2; // voters
+        n16 = 1; memcpy(frame + off, &n16, 2); off += 2;          // groups
+        memset(frame + off, 0, 3 * 32);
+        for (int v = 0; v < 3; v++) frame[off + v * 32] = (uint8_t)(0xD0 + v);
+        off += 3 * 32;
+        memcpy(frame + off, block.id, 32); off += 32;
+        n16 = 3; memcpy(frame + off, &n16, 2); off += 2;
+        for (uint16_t v = 0; v < 3; v++) {
+            uint16_t entry = (uint16_t)(v | (v == 0 ? 0x8000 : 0)); // one preference
+            memcpy(frame + off, &entry, 2); off += 2;
+        }
+
+        lux_consensus_stats_t frame_stats;
+        lux_consensus_get_stats(chain, &frame_stats);
+        uint64_t before_frame = frame_stats.votes_processed;
+        err = lux_consensus_ingest_vote_frame(chain, frame, sizeof(frame));
+        lux_consensus_get_stats(chain, &frame_stats);
+        ASSERT_TEST(err == LUX_SUCCESS &&
+                    frame_stats.votes_processed == before_frame + 3,
+                    "Vote frame applied from wire buffer");
+
+        // Same frame again: every vote is a replay, nothing counted twice
+        err = lux_consensus_ingest_vote_frame(chain, frame, sizeof(frame));
+        lux_consensus_get_stats(chain, &frame_stats);
+        ASSERT_TEST(err == LUX_SUCCESS &&
+                    frame_stats.votes_processed == before_frame + 3,
+                    "Replayed vote frame suppressed");
+
+        frame[0] ^= 0xFF; // corrupt the magic
+        ASSERT_TEST(lux_consensus_ingest_vote_frame(chain, frame, sizeof(frame))
+                    == LUX_ERROR_INVALID_PARAMS,
+                    "Malformed vote frame rejected");
+        frame[0] ^= 0xFF;
+        ASSERT_TEST(lux_consensus_ingest_vote_frame(chain, frame, sizeof(frame) - 1)
+                    == LUX_ERROR_INVALID_PARAMS,
+                    "Truncated vote frame rejected");
+    }
+
+    // Test 7: Asynchronous vote pipeline
+    printf("\n%s--- Test 7: Async Vote Pipeline ---%s\n", COLOR_YELLOW, COLOR_RESET);
+    lux_vote_t async_vote;
+    memset(&async_vote, 0, sizeof(async_vote));
+    memcpy(async_vote.block_id, block.id, 32);
+
+    for (int i = 0; i < 10; i++) {
+        async_vote.voter_id[0] = (uint8_t)(100 + i);
+        err = lux_consensus_submit_vote(chain, &async_vote);
+        if (err != LUX_SUCCESS) break;
+    }
+    ASSERT_TEST(err == LUX_SUCCESS, "Submit votes to async pipeline");
+
+    // The worker drains asynchronously; poll stats briefly for the count
+    lux_consensus_stats_t async_stats;
+    uint64_t before = batch_stats.votes_processed;
+    bool drained = false;
+    for (int i = 0; i < 200 && !drained; i++) {
+        lux_consensus_get_stats(chain, &async_stats);
+        if (async_stats.votes_processed >= before + 10) {
+            drained = true;
+        } else {
+            struct timespec ts = {0, 10000000}; // 10ms
+            nanosleep(&ts, NULL);
+        }
+    }
+    ASSERT_TEST(drained, "Async pipeline drained submitted votes");
+
+    // Verify callback: rejected blocks never enter the table, accepted ones
+    // do; the callback runs outside engine locks (see header contract)
+    {
+        lux_chain_t* vchain = lux_chain_new_default();
+        lux_consensus_register_verify_callback(vchain, reject_bd_blocks, NULL);
+
+        lux_block_t vb;
+        memset(&vb, 0, sizeof(vb));
+        vb.height = 1;
+        vb.id[0] = 0xBD; // verifier refuses this prefix
+        ASSERT_TEST(lux_chain_add_block(vchain, &vb) == LUX_ERROR_CONSENSUS_FAILED,
+                    "Verify callback rejects bad block");
+        bool vfound;
+        ASSERT_TEST(lux_consensus_is_accepted(vchain, vb.id, &vfound) ==
+                    LUX_ERROR_INVALID_STATE, "Rejected block not in table");
+
+        vb.id[0] = 0x7D;
+        ASSERT_TEST(lux_chain_add_block(vchain, &vb) == LUX_SUCCESS,
+                    "Verify callback admits good block");
+        lux_chain_destroy(vchain);
+    }
+
+    // Shared worker pool: two chains drained by one group, no per-chain
+    // threads
+    {
+        lux_engine_group_t* group = lux_engine_group_new(2);
+        ASSERT_TEST(group != NULL, "Create engine group");
+
+        lux_chain_t* table_a = lux_chain_new_default();
+        lux_chain_t* table_b = lux_chain_new_default();
+        err = lux_engine_group_add(group, table_a);
+        lux_error_t err_b = lux_engine_group_add(group, table_b);
+        ASSERT_TEST(err == LUX_SUCCESS && err_b == LUX_SUCCESS,
+                    "Register chains with group");
+
+        lux_block_t gb;
+        memset(&gb, 0, sizeof(gb));
+        gb.height = 1;
+        gb.id[0] = 0xA1;
+        lux_chain_add_block(table_a, &gb);
+        gb.id[0] = 0xB1;
+        lux_chain_add_block(table_b, &gb);
+
+        lux_vote_t gv;
+        memset(&gv, 0, sizeof(gv));
+        for (int i = 0; i < 16; i++) {
+            gv.voter_id[0] = (uint8_t)(i + 1);
+            gv.block_id[0] = 0xA1;
+            lux_consensus_submit_vote(table_a, &gv);
+            gv.block_id[0] = 0xB1;
+            lux_consensus_submit_vote(table_b, &gv);
+        }
+
+        bool group_drained = false;
+        for (int i = 0; i < 200 && !group_drained; i++) {
+            lux_consensus_stats_t sa, sb;
+            lux_consensus_get_stats(table_a, &sa);
+            lux_consensus_get_stats(table_b, &sb);
+            // +1 each: the add itself counts one processed vote
+            if (sa.votes_processed >= 17 && sb.votes_processed >= 17) {
+                group_drained = true;
+            } else {
+                struct timespec ts = {0, 10000000}; // 10ms
+                nanosleep(&ts, NULL);
+            }
+        }
+        ASSERT_TEST(group_drained, "Group workers drained both chains");
+
+        // A registered chain must not spawn its own queue consumer
+        ASSERT_TEST(lux_chain_start(table_a) == LUX_ERROR_INVALID_STATE,
+                    "lux_chain_start rejected while chain is in a group");
+
+        ASSERT_TEST(lux_engine_group_remove(group, table_a) == LUX_SUCCESS,
+                    "Remove chain from group");
+        err = lux_chain_start(table_a);
+        ASSERT_TEST(err == LUX_SUCCESS, "lux_chain_start works after remove");
+        lux_chain_stop(table_a);
+        lux_engine_group_destroy(group);
+        lux_chain_destroy(table_a);
+        lux_chain_destroy(table_b);
+    }
+
+    // Test 8: Block table growth under many inserts
+    printf("\n%s--- Test 8: Block Table Growth ---%s\n", COLOR_YELLOW, COLOR_RESET);
+    lux_chain_t* big_chain = lux_chain_new_default();
+    ASSERT_TEST(big_chain != NULL, "Create chain for growth test");
+
+    lux_block_t many;
+    memset(&many, 0, sizeof(many));
+    for (uint32_t n = 0; n < 5000; n++) {
+        memcpy(many.id, &n, sizeof(n));
+        many.id[31] = 0x42;
+        many.height = n + 1;
+        err = lux_chain_add_block(big_chain, &many);
+        if (err != LUX_SUCCESS) break;
+    }
+    ASSERT_TEST(err == LUX_SUCCESS, "Add 5000 blocks");
+
+    // Every inserted block must still be findable after table growth
+    bool all_found = true;
+    bool found;
+    for (uint32_t n = 0; n < 5000 && all_found; n++) {
+        memcpy(many.id, &n, sizeof(n));
+        many.id[31] = 0x42;
+        if (lux_consensus_is_accepted(big_chain, many.id, &found) != LUX_SUCCESS) {
+            all_found = false;
+        }
+    }
+    ASSERT_TEST(all_found, "All 5000 blocks found after growth");
+
+    // Batch acceptance: all 5000 known IDs flagged, one unknown ID not
+    {
+        enum { BATCH_N = 128 };
+        uint8_t batch_ids[BATCH_N * 32];
+        uint8_t batch_flags[BATCH_N];
+        memset(batch_ids, 0, sizeof(batch_ids));
+        for (uint32_t n = 0; n < BATCH_N - 1; n++) {
+            memcpy(batch_ids + n * 32, &n, sizeof(n));
+            batch_ids[n * 32 + 31] = 0x42;
+        }
+        memset(batch_ids + (BATCH_N - 1) * 32, 0xEE, 32); // unknown
+        err = lux_consensus_is_accepted_batch(big_chain, batch_ids, BATCH_N,
+                                              batch_flags);
+        bool batch_ok = (err == LUX_SUCCESS);
+        for (uint32_t n = 0; n < BATCH_N - 1 && batch_ok; n++) {
+            if (!batch_flags[n]) batch_ok = false;
+        }
+        ASSERT_TEST(batch_ok && batch_flags[BATCH_N - 1] == 0,
+                    "Batch acceptance flags known and unknown IDs");
+    }
+
+    // Event ring: every accepted block emitted a binary record (drops
+    // after the ring filled are flagged per record, not silently lost)
+    {
+        lux_event_t events[64];
+        size_t num_events = 0;
+        err = lux_consensus_poll_events(big_chain, events, 64, &num_events);
+        bool events_ok = (err == LUX_SUCCESS && num_events == 64);
+        for (size_t i = 0; i < num_events && events_ok; i++) {
+            if (events[i].type != LUX_EVENT_BLOCK_ACCEPTED ||
+                events[i].payload == 0) {
+                events_ok = false;
+            }
+        }
+        ASSERT_TEST(events_ok, "Event ring reports accepted blocks");
+    }
+
+    // Height index: direct lookup and ordered ranged iteration
+    lux_block_t by_height;
+    err = lux_chain_get_block_by_height(big_chain, 2500, &by_height);
+    uint32_t expect_n = 2499; // height n+1 holds id n
+    ASSERT_TEST(err == LUX_SUCCESS &&
+                memcmp(by_height.id, &expect_n, sizeof(expect_n)) == 0 &&
+                by_height.height == 2500,
+                "Height index finds block by height");
+
+    uint64_t visited = 0;
+    last_visited_height = 0;
+    iterate_in_order = true;
+    err = lux_chain_iterate_accepted(big_chain, 1, 100, visit_count_ordered,
+                                     NULL, &visited);
+    ASSERT_TEST(err == LUX_SUCCESS && visited == 100 && iterate_in_order,
+                "Ranged iteration walks heights in order");
+
+    // Decision latency histogram: 5000 accepted blocks means 5000 samples,
+    // with percentiles in order and bounded by the max
+    lux_latency_stats_t lat;
+    err = lux_consensus_get_decision_latency(big_chain, &lat);
+    ASSERT_TEST(err == LUX_SUCCESS && lat.count >= 5000 &&
+                lat.p50_ns <= lat.p99_ns && lat.p99_ns <= lat.p999_ns &&
+                lat.p999_ns <= lat.max_ns && lat.max_ns > 0,
+                "Decision latency percentiles exported");
+
+    uint64_t frontier = 0;
+    err = lux_consensus_get_finalized_height(big_chain, &frontier);
+    ASSERT_TEST(err == LUX_SUCCESS && frontier == 5000,
+                "Finalized height tracks highest accepted block");
+
+    // No decision callback is registered on big_chain, so accepted blocks
+    // stay queued until drained explicitly
+    uint8_t drained_ids[16 * 32];
+    size_t num_drained = 0;
+    err = lux_consensus_drain_decisions(big_chain, 16, drained_ids, &num_drained);
+    ASSERT_TEST(err == LUX_SUCCESS && num_drained == 16, "Drain queued decisions");
+
+    // Prune the decided history below height 4001: heights 1..4000 go,
+    // 4001..5000 stay resident
+    size_t reclaimed = 0;
+    err = lux_chain_prune(big_chain, 4001, &reclaimed);
+    ASSERT_TEST(err == LUX_SUCCESS && reclaimed > 0, "Prune reclaims memory");
+
+    uint32_t pruned_n = 100, kept_n = 4500;
+    memset(many.id, 0, 32);
+    memcpy(many.id, &pruned_n, sizeof(pruned_n));
+    many.id[31] = 0x42;
+    ASSERT_TEST(lux_consensus_is_accepted(big_chain, many.id, &found) ==
+                LUX_ERROR_INVALID_STATE, "Pruned block evicted from table");
+    memcpy(many.id, &kept_n, sizeof(kept_n));
+    ASSERT_TEST(lux_consensus_is_accepted(big_chain, many.id, &found) ==
+                LUX_SUCCESS && found, "Block above frontier still resident");
+    ASSERT_TEST(lux_chain_get_block_by_height(big_chain, 100, &by_height) ==
+                LUX_ERROR_INVALID_STATE,
+                "Pruned height evicted from height index");
+
+    // Memory accounting: per-structure breakdown with high-water marks,
+    // and the total is the sum of the category currents
+    lux_memory_stats_t mem;
+    err = lux_chain_memory_usage(big_chain, &mem);
+    ASSERT_TEST(err == LUX_SUCCESS &&
+                mem.block_nodes.current > 0 &&
+                mem.table_entries.current > 0 &&
+                mem.indexes.current > 0 &&
+                mem.block_nodes.peak >= mem.block_nodes.current &&
+                mem.table_entries.peak >= mem.table_entries.current &&
+                mem.payloads.peak >= mem.payloads.current &&
+                mem.total_current == mem.block_nodes.current +
+                                     mem.payloads.current +
+                                     mem.table_entries.current +
+                                     mem.children_arrays.current +
+                                     mem.vote_cache.current +
+                                     mem.voter_state.current +
+                                     mem.indexes.current,
+                "Memory usage breaks down by structure");
+    lux_chain_destroy(big_chain);
+
+    // Capacity hints: a presized chain absorbs the same workload without
+    // growing children arrays on the hot path
+    lux_config_t hinted_config;
+    memset(&hinted_config, 0, sizeof(hinted_config));
+    hinted_config.node_count = 5;
+    hinted_config.expected_blocks = 2048;
+    hinted_config.expected_children_per_block = 2048;
+    lux_chain_t* hinted = lux_chain_new(&hinted_config);
+    ASSERT_TEST(hinted != NULL, "Create chain with capacity hints");
+    for (uint32_t n = 0; n < 2000; n++) {
+        memcpy(many.id, &n, sizeof(n));
+        many.id[31] = 0x43;
+        many.height = n + 1;
+        err = lux_chain_add_block(hinted, &many);
+        if (err != LUX_SUCCESS) break;
+    }
+    lux_consensus_stats_ex_t hinted_ex;
+    memset(&hinted_ex, 0, sizeof(hinted_ex));
+    hinted_ex.version = LUX_STATS_EX_VERSION;
+    lux_consensus_get_stats_ex(hinted, &hinted_ex);
+    ASSERT_TEST(err == LUX_SUCCESS && hinted_ex.children_reallocs == 0,
+                "Hinted chain adds blocks without children reallocs");
+    err = lux_chain_memory_usage(hinted, &mem);
+    ASSERT_TEST(err == LUX_SUCCESS && mem.vote_cache.current > 0,
+                "Hinted chain accounts preallocated vote cache");
+    lux_chain_destroy(hinted);
+
+    // Repeated pruning of a chained pipeline: blocks parented to their
+    // predecessor must survive two prune passes with valid linkage (the
+    // simplified path registers children, so prune can repair backlinks)
+    lux_chain_t* pchain = lux_chain_new_default();
+    lux_block_t pb;
+    memset(&pb, 0, sizeof(pb));
+    uint8_t prev_pid[32] = {0};
+    for (uint32_t n = 0; n < 100; n++) {
+        memset(pb.id, 0, 32);
+        memcpy(pb.id, &n, sizeof(n));
+        pb.id[31] = 0x55;
+        memcpy(pb.parent_id, prev_pid, 32);
+        pb.height = n + 1;
+        err = lux_chain_add_block(pchain, &pb);
+        if (err != LUX_SUCCESS) break;
+        memcpy(prev_pid, pb.id, 32);
+    }
+    ASSERT_TEST(err == LUX_SUCCESS, "Build parented pipeline");
+    size_t preclaimed = 0;
+    err = lux_chain_prune(pchain, 50, &preclaimed);
+    ASSERT_TEST(err == LUX_SUCCESS && preclaimed > 0,
+                "First prune of chained history");
+    err = lux_chain_prune(pchain, 90, &preclaimed);
+    uint32_t kept_pn = 94; // height 95
+    memset(pb.id, 0, 32);
+    memcpy(pb.id, &kept_pn, sizeof(kept_pn));
+    pb.id[31] = 0x55;
+    bool pfound = false;
+    ASSERT_TEST(err == LUX_SUCCESS &&
+                lux_consensus_is_accepted(pchain, pb.id, &pfound) ==
+                    LUX_SUCCESS && pfound,
+                "Second prune leaves survivors with valid linkage");
+    lux_chain_destroy(pchain);
+
+    // Test 9: Persistent block log
+    printf("\n%s--- Test 9: Persistent Block Log ---%s\n", COLOR_YELLOW, COLOR_RESET);
+    const char* log_path = "/tmp/lux_test_block_log.bin";
+    unlink(log_path);
+
+    lux_chain_t* durable = lux_chain_open(log_path, NULL);
+    ASSERT_TEST(durable != NULL, "Open chain with fresh block log");
+
+    lux_block_t logged;
+    memset(&logged, 0, sizeof(logged));
+    const char* logged_data = "persisted payload";
+    for (uint32_t n = 0; n < 3; n++) {
+        memset(logged.id, 0, 32);
+        memcpy(logged.id, &n, sizeof(n));
+        logged.id[31] = 0x77;
+        logged.height = n + 1;
+        logged.timestamp = 1700000000 + n;
+        logged.data = (void*)logged_data;
+        logged.data_size = strlen(logged_data);
+        err = lux_chain_add_block(durable, &logged);
+        if (err != LUX_SUCCESS) break;
+    }
+    ASSERT_TEST(err == LUX_SUCCESS, "Append blocks to logged chain");
+    lux_chain_destroy(durable);
+
+    // Reopen and verify the blocks were replayed from the log
+    durable = lux_chain_open(log_path, NULL);
+    ASSERT_TEST(durable != NULL, "Reopen chain from existing log");
+
+    bool replayed = true;
+    bool there;
+    for (uint32_t n = 0; n < 3 && replayed; n++) {
+        memset(logged.id, 0, 32);
+        memcpy(logged.id, &n, sizeof(n));
+        logged.id[31] = 0x77;
+        if (lux_consensus_is_accepted(durable, logged.id, &there) != LUX_SUCCESS
+            || !there) {
+            replayed = false;
+        }
+    }
+    ASSERT_TEST(replayed, "All logged blocks accepted after replay");
+
+    lux_consensus_stats_t durable_stats;
+    lux_consensus_get_stats(durable, &durable_stats);
+    ASSERT_TEST(durable_stats.blocks_accepted == 3, "Replay restored stats");
+    lux_chain_destroy(durable);
+    unlink(log_path);
+
+    // Write-ahead vote journal: mid-round votes survive a restart, replay
+    // through the batch path, and the file truncates once the block decides
+    const char* journal_path = "/tmp/lux_test_vote_journal.bin";
+    unlink(journal_path);
+
+    lux_config_t jcfg = {
+        .node_count = 5,
+        .k = 3,
+        .alpha = 3,
+        .beta = 4
+    };
+    lux_chain_t* jchain = NULL;
+    err = lux_consensus_engine_create(&jchain, &jcfg);
+    ASSERT_TEST(err == LUX_SUCCESS, "Create voting engine for journal");
+    size_t journal_replayed = 99;
+    err = lux_consensus_attach_vote_journal(jchain, journal_path,
+                                            &journal_replayed);
+    ASSERT_TEST(err == LUX_SUCCESS && journal_replayed == 0,
+                "Attach fresh vote journal");
+    ASSERT_TEST(lux_consensus_attach_vote_journal(jchain, journal_path, NULL)
+                == LUX_ERROR_INVALID_STATE, "Double attach rejected");
+
+    lux_block_t jblock;
+    memset(&jblock, 0, sizeof(jblock));
+    jblock.id[0] = 0xEE;
+    jblock.height = 1;
+    err = lux_consensus_add_block(jchain, &jblock);
+    ASSERT_TEST(err == LUX_SUCCESS, "Add undecided block for journaling");
+
+    // Three confidence votes: one short of beta, so the block stays
+    // undecided and the votes land in the journal (one group commit)
+    lux_vote_t jvotes[3];
+    memset(jvotes, 0, sizeof(jvotes));
+    for (int i = 0; i < 3; i++) {
+        memcpy(jvotes[i].block_id, jblock.id, 32);
+        jvotes[i].voter_id[0] = (uint8_t)(i + 1);
+    }
+    err = lux_consensus_process_votes(jchain, jvotes, 3, NULL);
+    bool jaccepted = true;
+    lux_consensus_is_accepted(jchain, jblock.id, &jaccepted);
+    ASSERT_TEST(err == LUX_SUCCESS && !jaccepted,
+                "Mid-round votes journaled, block still undecided");
+    lux_consensus_engine_destroy(jchain);
+
+    // "Restart": fresh engine, same block, replay restores the three counts
+    err = lux_consensus_engine_create(&jchain, &jcfg);
+    ASSERT_TEST(err == LUX_SUCCESS, "Recreate engine after restart");
+    err = lux_consensus_add_block(jchain, &jblock);
+    ASSERT_TEST(err == LUX_SUCCESS, "Re-add block after restart");
+    err = lux_consensus_attach_vote_journal(jchain, journal_path,
+                                            &journal_replayed);
+    ASSERT_TEST(err == LUX_SUCCESS && journal_replayed == 3,
+                "Journal replayed through batch vote path");
+
+    // One more vote crosses beta: the restarted node needed one round, not
+    // four, and the decided journal truncates back to its header
+    lux_vote_t jfinal;
+    memset(&jfinal, 0, sizeof(jfinal));
+    memcpy(jfinal.block_id, jblock.id, 32);
+    jfinal.voter_id[0] = 4;
+    err = lux_consensus_process_vote(jchain, &jfinal);
+    jaccepted = false;
+    lux_consensus_is_accepted(jchain, jblock.id, &jaccepted);
+    ASSERT_TEST(err == LUX_SUCCESS && jaccepted,
+                "Replayed counts finish with one post-restart vote");
+
+    struct stat jst;
+    ASSERT_TEST(stat(journal_path, &jst) == 0 && jst.st_size == 16,
+                "Decided journal truncated to header");
+    lux_consensus_engine_destroy(jchain);
+    unlink(journal_path);
+
+    // Ordered delivery vs rejection: a child that decides while its parent
+    // is undecided parks on the deferred list; when the parent loses its
+    // conflict set, the rejection must release the child, not strand it
+    lux_chain_t* ochain = NULL;
+    err = lux_consensus_engine_create(&ochain, &jcfg);
+    ASSERT_TEST(err == LUX_SUCCESS, "Create engine for ordering test");
+
+    lux_block_t op, orival, ochild;
+    memset(&op, 0, sizeof(op));
+    op.id[0] = 0xA1;
+    op.height = 1;
+    memset(&orival, 0, sizeof(orival));
+    orival.id[0] = 0xA2;
+    orival.height = 1;
+    memset(&ochild, 0, sizeof(ochild));
+    ochild.id[0] = 0xA3;
+    ochild.height = 2;
+    memcpy(ochild.parent_id, op.id, 32);
+    err = lux_consensus_add_block(ochain, &op);
+    if (err == LUX_SUCCESS) err = lux_consensus_add_block(ochain, &orival);
+    if (err == LUX_SUCCESS) err = lux_consensus_add_block(ochain, &ochild);
+    ASSERT_TEST(err == LUX_SUCCESS, "Add parent, rival, and child");
+
+    lux_vote_t ovote;
+    memset(&ovote, 0, sizeof(ovote));
+    memcpy(ovote.block_id, ochild.id, 32);
+    for (int i = 0; i < 4; i++) {
+        ovote.voter_id[0] = (uint8_t)(0x30 + i);
+        lux_consensus_process_vote(ochain, &ovote);
+    }
+    uint8_t odrained[4 * 32];
+    size_t onum = 99;
+    err = lux_consensus_drain_decisions(ochain, 4, odrained, &onum);
+    ASSERT_TEST(err == LUX_SUCCESS && onum == 0,
+                "Decided child parked behind undecided parent");
+
+    // The rival decides, rejecting the parent — the child must surface,
+    // after the rival
+    memcpy(ovote.block_id, orival.id, 32);
+    for (int i = 0; i < 4; i++) {
+        ovote.voter_id[0] = (uint8_t)(0x40 + i);
+        lux_consensus_process_vote(ochain, &ovote);
+    }
+    err = lux_consensus_drain_decisions(ochain, 4, odrained, &onum);
+    ASSERT_TEST(err == LUX_SUCCESS && onum == 2 &&
+                memcmp(odrained, orival.id, 32) == 0 &&
+                memcmp(odrained + 32, ochild.id, 32) == 0,
+                "Rejected parent releases parked child in order");
+
+    // Voting engines also account voter-dedup state (registry + bitmaps)
+    // and the conflict-set/height-index structures
+    err = lux_chain_memory_usage(ochain, &mem);
+    ASSERT_TEST(err == LUX_SUCCESS && mem.voter_state.current > 0 &&
+                mem.indexes.current > 0,
+                "Voter state and index structures accounted");
+    lux_consensus_engine_destroy(ochain);
+
+    // Test 10: Cleanup
+    printf("\n%s--- Test 10: Cleanup ---%s\n", COLOR_YELLOW, COLOR_RESET);
     lux_chain_stop(chain);
     lux_chain_destroy(chain);
     ASSERT_TEST(1, "Stop and destroy first chain");
+    ASSERT_TEST(payloads_released == 1, "Owned payload released at teardown");
     
     lux_chain_stop(custom_chain);
     lux_chain_destroy(custom_chain);